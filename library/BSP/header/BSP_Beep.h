@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  22 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __BSP_BEEP_H__
@@ -29,6 +29,24 @@
     #define BEEP_ON     0       // Beep ON.
     #define BEEP_OFF    1       // Beep OFF.
 
+    /*******************************************************
+     * Beep Power (permille)
+     *******************************************************/
+    #define BEEP_POWER_MAX  1000    // Maximum power (50% duty ratio).
+
+    /*******************************************************
+     * Beep Event Types
+     *******************************************************/
+    #define EVT_BEEP_END            0   // End of the beep interval.
+    #define EVT_BEEP_SEQUENCE_END   1   // End of the note sequence (queue and melody are empty).
+
+    /*******************************************************
+     * Beep Note Queue Length (number of notes)
+     *******************************************************/
+    #ifndef BEEP_QUEUE_LENGTH
+        #define BEEP_QUEUE_LENGTH   8
+    #endif
+
     /*******************************************************
      * BEEP OBJECT STRUCTURER
      *******************************************************/
@@ -37,8 +55,9 @@
         uint16_t    ticks;      // Tick counter.
         uint16_t    counter;    // Number of beep.
         uint16_t    status;     // Beep status.
-        float       frequency;  // Beep frequency (Hz).
-        float       power;      // Beep ower (0.0 - 1.0).
+        uint16_t    frequency;  // Beep frequency (Hz).
+        uint16_t    power;      // Beep power (permille, 0 - 1000).
+        uint16_t    scale;      // Duty scale of the power (OC5RS = PR3*scale/65536).
         callback_t  callback;   // Callback function.
     }beep_t;
 
@@ -46,6 +65,7 @@
      * BEEP OBJECT STRUCTURER
      *******************************************************/
     typedef struct {
+        int      type;          // Beep event type.
         uint16_t interval;      // Beep interval (in mS).
         uint16_t counter;       // Number of beep.
         float    frequency;     // Beep frequency.
@@ -53,6 +73,16 @@
         beep_t   *sender;       // Beep object.
     }beep_event_t;
 
+    /*******************************************************
+     * BEEP NOTE STRUCTURER (used by the note sequencer)
+     *******************************************************/
+    typedef struct {
+        uint16_t frequency;     // Note frequency (Hz), 0 for a silent note.
+        uint16_t duration;      // Note duration (in mS).
+        uint16_t rest;          // Silent interval after the note (in mS).
+        uint16_t power;         // Note power (permille, 0-1000).
+    }beep_note_t;
+
     /************************************************************
     * Beep_Init
     * Initializes the beep peripherals and parameters.
@@ -67,6 +97,14 @@
     *************************************************************/
     void Beep_SetFrequency(float freq);
 
+    /************************************************************
+    * Beep_SetFrequencyHz
+    * Sets the frequency of the beep sound using integer arithmetic.
+    * Parameter:
+    * - frequency: Frequency of the beep sound (1Hz - 65535Hz).
+    *************************************************************/
+    void Beep_SetFrequencyHz(uint16_t frequency);
+
     /************************************************************
     * Beep_SetCallback
     * Set callback function of the beep sound. The callback
@@ -84,6 +122,14 @@
     *************************************************************/
     void Beep_SetPower(float freq);
 
+    /************************************************************
+    * Beep_SetPowerPermille
+    * Set the power of the beep sound using integer arithmetic.
+    * Parameter:
+    * - power: Power of the beep sound (0 - BEEP_POWER_MAX).
+    *************************************************************/
+    void Beep_SetPowerPermille(uint16_t power);
+
     /************************************************************
     * Beep
     * Starts the beep sound with the previous settings of the
@@ -101,6 +147,70 @@
     *************************************************************/
     void Beep_Play(float frequency, uint16_t interval);
 
+    /************************************************************
+    * Beep_PlayHz
+    * Play the beep sound with the given frequency (Hz) and interval.
+    * No floating-point operation is performed.
+    * Parameters:
+    * - frequency: Frequency of the beep sound (1Hz - 65535Hz).
+    * - interval: Period (length) of the beep sound.
+    *************************************************************/
+    void Beep_PlayHz(uint16_t frequency, uint16_t interval);
+
+    /************************************************************
+    * Beep_Enqueue
+    * Appends a note to the note queue. The sequencer plays the
+    * queued notes one after another in the BEEP_TickedExecutor.
+    * When the queue becomes empty, the callback function is called
+    * with the EVT_BEEP_SEQUENCE_END event.
+    * Returns false if the note queue is full.
+    * Parameters:
+    * - frequency: Note frequency (Hz), 0 for a silent note.
+    * - duration: Note duration (in mS).
+    * - power: Note power (0 - BEEP_POWER_MAX).
+    * - rest: Silent interval after the note (in mS).
+    *************************************************************/
+    bool Beep_Enqueue(uint16_t frequency, uint16_t duration, uint16_t power, uint16_t rest);
+
+    /************************************************************
+    * Beep_PlayMelody
+    * Plays a constant note table (melody). The notes are read
+    * directly from the table, they are not copied into the queue.
+    * The melody is played before the notes in the note queue.
+    * Parameters:
+    * - melody: Array of notes.
+    * - length: Number of notes in the array.
+    *************************************************************/
+    void Beep_PlayMelody(const beep_note_t *melody, uint16_t length);
+
+    /************************************************************
+    * Beep_Stop
+    * Stops the beep sound, the melody and clears the note queue.
+    *************************************************************/
+    void Beep_Stop(void);
+
+    /************************************************************
+    * Beep_IsBusy
+    * Returns true if the sequencer is playing notes.
+    *************************************************************/
+    bool Beep_IsBusy(void);
+
+    /************************************************************
+    * Beep_GetIdleTicks
+    * Returns the number of ticks to the next operation of the
+    * beep (0xFFFF if the beep is off and has no callback).
+    * Used by the tickless idle.
+    *************************************************************/
+    uint16_t Beep_GetIdleTicks(void);
+
+    /************************************************************
+    * Beep_GetDroppedEvents
+    * Returns the number of events (EVT_BEEP_END and
+    * EVT_BEEP_SEQUENCE_END) dropped because the queue of the
+    * dispatcher (BSP_Dispatch) was full.
+    *************************************************************/
+    uint16_t Beep_GetDroppedEvents(void);
+
     /************************************************************
     * BEEP_TickedExecutor
     * Performs beep sound execution.
@@ -0,0 +1,98 @@
+/************************************************************
+ * File:    BSP_Clock.h                                     *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __BSP_CLOCK_H__
+
+    #define __BSP_CLOCK_H__
+
+    #include <BSP_Mcu.h>
+
+    /*******************************************************
+     * FREE-RUNNING CLOCK
+     * The Timer5 counts the FCY (16MHz) divided by the
+     * CLOCK_PRESCALE. Its overflows (every 65536 counts)
+     * are counted by the Timer5 interrupt, the counter and
+     * the TMR5 form a 48-bit clock. The microsecond clock
+     * (32-bit) wraps every 71.6 minutes.
+     *******************************************************/
+
+    /*******************************************************
+     * Prescaler of the Timer5 (1 or 8)
+     * - 1: One count per instruction cycle (62.5nS), the
+     *      overflow interrupt occurs every 4.096mS.
+     * - 8: One count per 0.5uS, the overflow interrupt
+     *      occurs every 32.768mS (less wake-ups of the
+     *      tickless idle).
+     * The overflow interrupt wakes the tickless idle of the
+     * RTOS, the default is 8 if the BSP_TICKLESS_IDLE
+     * (BSP_Config.h) is set, otherwise 1.
+     *******************************************************/
+    #ifndef CLOCK_PRESCALE
+        #if BSP_TICKLESS_IDLE > 0
+            #define CLOCK_PRESCALE  8
+        #else
+            #define CLOCK_PRESCALE  1
+        #endif
+    #endif
+
+    #if CLOCK_PRESCALE == 1
+        #define CLOCK_US_SHIFT      4       // 16 counts per uS.
+    #elif CLOCK_PRESCALE == 8
+        #define CLOCK_US_SHIFT      1       // 2 counts per uS.
+    #else
+        #error "CLOCK_PRESCALE must be 1 or 8"
+    #endif
+
+    /*******************************************************
+     * Interrupt priority of the Timer5 (overflow counter)
+     *******************************************************/
+    #ifndef CLOCK_ISR_PRIORITY
+        #define CLOCK_ISR_PRIORITY  6
+    #endif
+
+    /*******************************************************
+     * Timestamp macros
+     * - CLOCK_STAMP_COUNTS(): Raw 16-bit timer count, the
+     *   cheapest stamp (a single read of the TMR5). The
+     *   difference of two stamps is valid up to 65535 counts.
+     * - CLOCK_STAMP(ts): Stores the microsecond clock in ts.
+     * - CLOCK_ELAPSED_US(ts): Microseconds since the stamp ts.
+     * - CLOCK_COUNTS_TO_US(counts): Converts timer counts.
+     *******************************************************/
+    #define CLOCK_STAMP_COUNTS()            ((uint16_t)TMR5)
+    #define CLOCK_STAMP(ts)                 ((ts) = Clock_GetMicros())
+    #define CLOCK_ELAPSED_US(ts)            ((uint32_t)(Clock_GetMicros() - (ts)))
+    #define CLOCK_COUNTS_TO_US(counts)      ((counts) >> CLOCK_US_SHIFT)
+
+
+    /************************************************************
+    * Clock_Init
+    * Initializes and starts the Timer5 (free-running clock).
+    *************************************************************/
+    void Clock_Init(void);
+
+
+    /************************************************************
+    * Clock_GetCounts
+    * Returns the lower 32 bits of the clock in timer counts
+    * (instruction cycles for the CLOCK_PRESCALE of 1).
+    * It can be called from any context, including ISRs.
+    *************************************************************/
+    uint32_t Clock_GetCounts(void);
+
+
+    /************************************************************
+    * Clock_GetMicros
+    * Returns the microseconds since the Clock_Init(). It is
+    * monotonic and wraps every 2^32 uS (71.6 minutes), use
+    * the unsigned difference of two values.
+    * It can be called from any context, including ISRs.
+    *************************************************************/
+    uint32_t Clock_GetMicros(void);
+
+#endif // __BSP_CLOCK_H__
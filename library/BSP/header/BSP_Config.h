@@ -37,6 +37,23 @@
      ********************************************************/
     #define CONFIG_SYSTEM_TIME_PER_TICK     1e-3
 
+    /********************************************************
+     * Execution profiler (see the BSP_Profile.h).
+     * 0: The profiling hooks are compiled out.
+     ********************************************************/
+    #ifndef BSP_PROFILE_ENABLE
+        #define BSP_PROFILE_ENABLE  0
+    #endif
+
+    /********************************************************
+     * Tickless idle of the RTOS (configUSE_TICKLESS_IDLE).
+     * It must match the FreeRTOSConfig.h, it selects the
+     * default prescaler of the Timer5 clock (BSP_Clock.h).
+     ********************************************************/
+    #ifndef BSP_TICKLESS_IDLE
+        #define BSP_TICKLESS_IDLE   1
+    #endif
+
     /********************************************************
      * Common callback function type.
      ********************************************************/
@@ -0,0 +1,156 @@
+/************************************************************
+ * File:    BSP_Dispatch.h                                  *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __BSP_DISPATCH_H__
+
+    #define __BSP_DISPATCH_H__
+
+    #include <BSP_Clock.h>
+
+    /*******************************************************
+     * CALLBACK DISPATCHER
+     * The modules post their callbacks with a copy of the
+     * event, the BSP_Executor performs one posted callback
+     * per pass, the highest priority first (FIFO within a
+     * priority). The execution time of the callbacks is
+     * measured, a callback longer than its budget is counted
+     * as an overrun and reported to the overrun callback.
+     * The switch, LED blink and beep callbacks and the alarms
+     * of the RTL timers are posted. A slow callback can be
+     * registered with the DISPATCH_PRIORITY_LOW, so it does
+     * not delay the callbacks of the higher priorities.
+     *******************************************************/
+
+    /*******************************************************
+     * Priorities of the callbacks
+     *******************************************************/
+    #define DISPATCH_PRIORITY_LOW       0
+    #define DISPATCH_PRIORITY_NORMAL    1   // Default priority.
+    #define DISPATCH_PRIORITY_HIGH      2
+    #define DISPATCH_PRIORITY_URGENT    3
+    #define DISPATCH_PRIORITIES         4
+
+    /*******************************************************
+     * Number of posted callbacks (shared by all priorities)
+     * When it is full, the posted callback is dropped.
+     *******************************************************/
+    #ifndef DISPATCH_QUEUE_LENGTH
+        #define DISPATCH_QUEUE_LENGTH   8
+    #endif
+
+    /*******************************************************
+     * Maximum size of the event copied with the callback
+     *******************************************************/
+    #ifndef DISPATCH_EVENT_SIZE
+        #define DISPATCH_EVENT_SIZE     24
+    #endif
+
+    /*******************************************************
+     * Number of registered callbacks (priority and budget)
+     *******************************************************/
+    #ifndef DISPATCH_MAX_CALLBACKS
+        #define DISPATCH_MAX_CALLBACKS  8
+    #endif
+
+    /*******************************************************
+     * Budget of the unregistered callbacks (in uS)
+     *******************************************************/
+    #ifndef DISPATCH_DEFAULT_BUDGET_US
+        #define DISPATCH_DEFAULT_BUDGET_US  2000
+    #endif
+
+    /*******************************************************
+     * DISPATCH STATISTIC STRUCTURE
+     * One object per registered callback, the unregistered
+     * callbacks share one object (callback is NULL).
+     *******************************************************/
+    typedef struct {
+        callback_t  callback;       // Callback function.
+        uint8_t     priority;       // Priority (DISPATCH_PRIORITY_x).
+        bool        overrun;        // The last execution exceeded the budget.
+        uint32_t    budget_us;      // Budget of one execution (in uS, 0: no budget).
+        uint32_t    calls;          // Number of executions.
+        uint32_t    overruns;       // Number of executions exceeding the budget.
+        uint32_t    last_us;        // Last execution time (in uS).
+        uint32_t    max_us;         // Maximum execution time (in uS).
+    }dispatch_stat_t;
+
+
+    /************************************************************
+    * Dispatch_Init
+    * Initializes the dispatcher.
+    *************************************************************/
+    void Dispatch_Init(void);
+
+
+    /************************************************************
+    * Dispatch_Register
+    * Sets the priority and the budget of the callback.
+    * Returns false if the table of the callbacks is full.
+    * Parameters:
+    * - callback: Callback function.
+    * - priority: Priority (DISPATCH_PRIORITY_x).
+    * - budget_us: Budget of one execution (in uS, 0: no budget).
+    *************************************************************/
+    bool Dispatch_Register(callback_t callback, uint8_t priority, uint32_t budget_us);
+
+
+    /************************************************************
+    * Dispatch_Post
+    * Posts the callback with a copy of the event. If the queue
+    * is full (or the event is too large), the callback is
+    * dropped and counted, and false is returned.
+    * It can be called from any context, including ISRs.
+    * Parameters:
+    * - callback: Callback function.
+    * - evt: Event passed to the callback.
+    * - size: Size of the event (bytes).
+    *************************************************************/
+    bool Dispatch_Post(callback_t callback, const void *evt, uint16_t size);
+
+
+    /************************************************************
+    * Dispatch_IsPending
+    * Returns true if a posted callback is waiting.
+    *************************************************************/
+    bool Dispatch_IsPending(void);
+
+
+    /************************************************************
+    * Dispatch_GetStat
+    * Copies the statistic of the callback (NULL: the shared
+    * statistic of the unregistered callbacks).
+    * Returns false if the callback is not registered.
+    *************************************************************/
+    bool Dispatch_GetStat(callback_t callback, dispatch_stat_t *stat);
+
+
+    /************************************************************
+    * Dispatch_GetDropped
+    * Returns the number of callbacks dropped because the
+    * queue was full (saturated at 65535).
+    *************************************************************/
+    uint16_t Dispatch_GetDropped(void);
+
+
+    /************************************************************
+    * Dispatch_SetOverrunCallback
+    * Sets the callback of the overruns, its event is the
+    * dispatch_stat_t of the overrunning callback.
+    *************************************************************/
+    void Dispatch_SetOverrunCallback(callback_t callback);
+
+
+    /************************************************************
+    * Dispatch_Executor
+    * Performs the posted callback of the highest priority.
+    * This function is called by the BSP_Executor.
+    *************************************************************/
+    inline void Dispatch_Executor(void);
+
+#endif // __BSP_DISPATCH_H__
@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  22 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __LED_BLINK_H__
@@ -19,6 +19,7 @@
     #define LED_STATE_BEGIN     1       // Begin. (phase-shifting starts)
     #define LED_STATE_ON        2       // ON.
     #define LED_STATE_OFF       3       // OFF.
+    #define LED_STATE_RUN       4       // Pattern script is running.
 
 
     /*******************************************************
@@ -28,6 +29,61 @@
     #define LED_MODE_FLS        1       // Flashing mode.
     #define LED_MODE_BLK        2       // Blinking mode.
     #define LED_MODE_PWM        3       // PWM blinking mode.
+    #define LED_MODE_PAT        4       // Pattern script mode.
+
+    /*******************************************************
+     * LED PATTERN SCRIPT
+     * A pattern is a constant byte array (kept in flash).
+     * Times are stored in units of LED_PATTERN_UNIT_MS,
+     * one byte per time (0 - 255 units). The times of the
+     * LED_PAT_x macros are 0 (no wait) or 10 - 2550 mS for
+     * the default unit, a constant time out of the range
+     * is a compile error (negative array size).
+     *******************************************************/
+    #ifndef LED_PATTERN_UNIT_MS
+        #define LED_PATTERN_UNIT_MS     10      // Time unit (in mS).
+    #endif
+    #ifndef LED_PATTERN_DEPTH
+        #define LED_PATTERN_DEPTH       2       // Nesting depth of the REPEAT/LOOP.
+    #endif
+    #ifndef LED_PATTERN_MAX_STEPS
+        #define LED_PATTERN_MAX_STEPS   16      // Operations executed per edge without a time.
+    #endif
+
+    #define LED_OP_END          0x00    // END                  : Completes the pattern, releases the dimmer.
+    #define LED_OP_ON           0x01    // ON,     time         : Turns on, then waits.
+    #define LED_OP_OFF          0x02    // OFF,    time         : Turns off, then waits.
+    #define LED_OP_DIM          0x03    // DIM,    level, time  : Sets the brightness (BSP_LedDim), then waits.
+    #define LED_OP_WAIT         0x04    // WAIT,   time         : Keeps the output, waits.
+    #define LED_OP_REPEAT       0x05    // REPEAT, count        : Repeats the operations up to the LOOP (count 0: skips them).
+    #define LED_OP_LOOP         0x06    // LOOP                 : End of the REPEAT block.
+    #define LED_OP_JUMP         0x07    // JUMP,   index        : Continues at the byte index of an earlier operation.
+
+    /*******************************************************
+     * A JUMP must go back to the byte index of an operation
+     * before it, a forward jump completes the pattern. The
+     * REPEAT blocks that start behind the target are left.
+     * A block deeper than LED_PATTERN_DEPTH runs once.
+     *******************************************************/
+
+    #define LED_PAT_MAX_MS          (255 * LED_PATTERN_UNIT_MS)
+    #define LED_PAT_VALID_MS(ms)    ((ms) == 0 || ((ms) >= LED_PATTERN_UNIT_MS && (ms) <= LED_PAT_MAX_MS))
+    #define LED_PAT_UNITS(ms)       ((ms)/LED_PATTERN_UNIT_MS + 0*sizeof(char[LED_PAT_VALID_MS(ms) ? 1 : -1]))
+    #define LED_PAT_END()           LED_OP_END
+    #define LED_PAT_ON(ms)          LED_OP_ON,  LED_PAT_UNITS(ms)
+    #define LED_PAT_OFF(ms)         LED_OP_OFF, LED_PAT_UNITS(ms)
+    #define LED_PAT_DIM(level, ms)  LED_OP_DIM, (level), LED_PAT_UNITS(ms)
+    #define LED_PAT_WAIT(ms)        LED_OP_WAIT, LED_PAT_UNITS(ms)
+    #define LED_PAT_REPEAT(count)   LED_OP_REPEAT, (count)
+    #define LED_PAT_LOOP()          LED_OP_LOOP
+    #define LED_PAT_JUMP(index)     LED_OP_JUMP, (index)
+
+    /*******************************************************
+     * The active LEDs are kept in a 16-bit mask
+     *******************************************************/
+    #if LED_MAX_COUNT > 16
+        #error "LED_MAX_COUNT must not be greater than 16"
+    #endif
 
     /*******************************************************
      * LED OBJECT STRUCTURE
@@ -35,13 +91,20 @@
     typedef struct {
         int16_t     id;                 // Id of LED.
         uint16_t    mode;               // Operation mode.
-        uint16_t    ticks;              // Tick counter.
+        uint32_t    origin;             // Tick of the cycle beginning.
+        uint32_t    deadline;           // Tick of the next edge.
         uint16_t    period;             // Signal period (in mS).
         uint16_t    width;              // Pulse-width period (in mS).
         uint16_t    shift;              // Phase-shift period (in mS).
         uint16_t    state;              // Operation state.
         uint16_t    counter;            // Completion counter (number of cycles).
         callback_t  callback;           // Callback function.
+        const uint8_t *script;          // Pattern script.
+        uint8_t     pc;                 // Byte index of the next operation.
+        uint8_t     depth;              // Number of the open REPEAT blocks.
+        uint8_t     loop_pc[LED_PATTERN_DEPTH];     // First operation of the REPEAT blocks.
+        uint8_t     loop_count[LED_PATTERN_DEPTH];  // Remaining rounds of the REPEAT blocks.
+        bool        dimmed;             // The LED is driven by the dimmer.
     }led_t;
 
     typedef struct {
@@ -96,6 +159,33 @@
     void Led_Pwm(int16_t id, uint16_t shift, uint16_t width, uint16_t period);
 
 
+    /************************************************************
+    * Led_Pattern
+    * Runs the pattern script on the LED. The script is interpreted
+    * by the LED_BlinkTickedExecutor, the callback function is
+    * called when the LED_OP_END is reached.
+    * Example (two short and one long flashes, forever):
+    *   static const uint8_t status[] = {
+    *       LED_PAT_REPEAT(2), LED_PAT_ON(100), LED_PAT_OFF(200), LED_PAT_LOOP(),
+    *       LED_PAT_ON(600), LED_PAT_OFF(1000), LED_PAT_JUMP(0)
+    *   };
+    *   Led_Pattern(LED_ID_0, status);
+    * Parameters:
+    * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
+    * - script: Pattern script.
+    *************************************************************/
+    void Led_Pattern(int16_t id, const uint8_t *script);
+
+
+    /************************************************************
+    * Led_PatternStop
+    * Stops the pattern script and turns the LED off.
+    * Parameter:
+    * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
+    *************************************************************/
+    void Led_PatternStop(int16_t id);
+
+
     /************************************************************
     * Led_SetChangedCallback
     * Sets callback function to the target LED.
@@ -110,6 +200,7 @@
     * Led_SetMode
     * Sets operation mode of the LED.
     * Used to switch from PWM mode to normal (LED) mode.
+    * Setting the LED_MODE_LED stops the running operation of the LED.
     * Parameters:
     * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
     * - mode: Mode of the LED operation.
@@ -117,11 +208,20 @@
     void Led_SetMode(int16_t id, int16_t mode);
 
 
+    /************************************************************
+    * Led_BlinkGetIdleTicks
+    * Returns the number of ticks to the next edge of the LEDs
+    * (0xFFFF if no LED is active). Used by the tickless idle.
+    *************************************************************/
+    uint16_t Led_BlinkGetIdleTicks(void);
+
+
     /************************************************************
     * LED_BlinkTickedExecutor
     * Performs led flshing/flashing execution.
     * This function must be called from the BSP_Main every
-    * ticked interval.
+    * ticked interval. Only the LEDs whose edge is due are
+    * processed, other ticks cost a single comparison.
     *************************************************************/
     inline void LED_BlinkTickedExecutor(void);
 
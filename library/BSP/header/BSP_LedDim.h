@@ -0,0 +1,132 @@
+/************************************************************
+ * File:    BSP_LedDim.h                                    *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __BSP_LED_DIM_H__
+
+    #define __BSP_LED_DIM_H__
+
+    #include <BSP_Led.h>
+
+    /*******************************************************
+     * LED DIMMER (Bit-Angle Modulation, BAM)
+     * The Timer4 interrupt outputs the 8 bits of the duty
+     * cycle, bit n is held for (LED_DIM_SLOT_CYCLES << n)
+     * instruction cycles. Only 8 interrupts are needed for
+     * one frame of 255 slots. The port images of all slots
+     * are precomputed, so each interrupt only writes the
+     * LATA and LATB (the LEDs are on RA2, RA4, RB2 and RB3).
+     *******************************************************/
+
+    /*******************************************************
+     * Number of instruction cycles of the shortest slot (bit 0)
+     * The frame rate is FCY/(255*LED_DIM_SLOT_CYCLES),
+     * 251Hz for the default value.
+     *******************************************************/
+    #ifndef LED_DIM_SLOT_CYCLES
+        #define LED_DIM_SLOT_CYCLES     250
+    #endif
+
+    /*******************************************************
+     * Interrupt priority of the Timer4 (dimmer)
+     *******************************************************/
+    #ifndef LED_DIM_ISR_PRIORITY
+        #define LED_DIM_ISR_PRIORITY    5
+    #endif
+
+    /*******************************************************
+     * Brightness levels
+     *******************************************************/
+    #define LED_DIM_MIN             0       // Off.
+    #define LED_DIM_MAX             255     // Full brightness.
+
+    #if (LED_DIM_SLOT_CYCLES * 128UL) > 65536UL
+        #error "LED_DIM_SLOT_CYCLES must not be greater than 512"
+    #endif
+
+
+    /************************************************************
+    * Led_DimInit
+    * Initializes the Timer4 and parameters of the dimmer.
+    * The Timer4 is started when the first LED is dimmed.
+    *************************************************************/
+    void Led_DimInit(void);
+
+
+    /************************************************************
+    * Led_DimSet
+    * Sets the brightness of the LED. The level is corrected by
+    * the gamma table (2.2), so the steps look linear to the eye.
+    * The LED is taken over by the dimmer, Led_Set()/Led_Clr()
+    * and the LED blinker must not be used with it.
+    * Parameters:
+    * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
+    * - level: Brightness level (LED_DIM_MIN - LED_DIM_MAX).
+    *************************************************************/
+    void Led_DimSet(int16_t id, uint8_t level);
+
+
+    /************************************************************
+    * Led_DimSetDuty
+    * Same as the Led_DimSet(), but the duty cycle is written
+    * directly without the gamma correction.
+    * Parameters:
+    * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
+    * - duty: Duty cycle (0 - 255).
+    *************************************************************/
+    void Led_DimSetDuty(int16_t id, uint8_t duty);
+
+
+    /************************************************************
+    * Led_DimFade
+    * Fades the LED from its current level to the given level.
+    * The level is updated every tick in the LED_DimTickedExecutor.
+    * Parameters:
+    * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
+    * - level: Final brightness level (LED_DIM_MIN - LED_DIM_MAX).
+    * - interval: Fading interval (in mS).
+    *************************************************************/
+    void Led_DimFade(int16_t id, uint8_t level, uint16_t interval);
+
+
+    /************************************************************
+    * Led_DimGet
+    * Returns the current brightness level of the LED.
+    * Parameter:
+    * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
+    *************************************************************/
+    uint8_t Led_DimGet(int16_t id);
+
+
+    /************************************************************
+    * Led_DimRelease
+    * Releases the LED from the dimmer and turns it off.
+    * The Timer4 is stopped when no LED is dimmed.
+    * Parameter:
+    * - id: Id of the target LED (LED_ID_0, ..., LED_ID_3).
+    *************************************************************/
+    void Led_DimRelease(int16_t id);
+
+
+    /************************************************************
+    * Led_DimIsIdle
+    * Returns true if no LED is fading (no tick is needed).
+    * The BAM output runs on the Timer4, it keeps running in
+    * the Idle mode.
+    *************************************************************/
+    bool Led_DimIsIdle(void);
+
+
+    /************************************************************
+    * LED_DimTickedExecutor
+    * Performs the fading of the LEDs.
+    * This function must be called from the BSP_Main every
+    * ticked interval.
+    *************************************************************/
+    inline void LED_DimTickedExecutor(void);
+
+#endif // __BSP_LED_DIM_H__
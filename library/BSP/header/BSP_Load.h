@@ -0,0 +1,100 @@
+/************************************************************
+ * File:    BSP_Load.h                                      *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __BSP_LOAD_H__
+
+    #define __BSP_LOAD_H__
+
+    #include <BSP_Clock.h>
+
+    /*******************************************************
+     * CPU LOAD METER
+     * The idle time is measured by the Timer5 (BSP_Clock),
+     * the load is the remaining (busy) part of the window.
+     * - Pure-BSP and BSP+RTL: The main loop (System_Start,
+     *   ecc.h) enters the idle state when neither the BSP nor
+     *   the RTL has a pending work, and leaves it otherwise.
+     * - RTOS: The idle task is accounted as idle by the
+     *   traceTASK_SWITCHED_IN/OUT (FreeRTOSConfig.h), except
+     *   the BSP and RTL work of its co-routine. The tickless
+     *   idle time is also idle.
+     * The UARTs have no pending work (see the BSP_Executor),
+     * their receive callbacks of a pass without any other
+     * work are accounted as idle.
+     * The time of the ISRs is included in the state they
+     * interrupted. The loads are in permille (0 - 1000).
+     *******************************************************/
+
+    /*******************************************************
+     * Windows of the load meter (in ticks)
+     *******************************************************/
+    #define LOAD_WINDOW_TICKS       1000    // Short window, 1 second.
+    #define LOAD_WINDOW_COUNT       10      // Long window, 10 short windows.
+
+
+    /************************************************************
+    * Load_Init
+    * Initializes the load meter. The Clock_Init() must be called first.
+    *************************************************************/
+    void Load_Init(void);
+
+
+    /************************************************************
+    * Load_IdleEnter
+    * Starts an idle interval (ignored if already idle).
+    * It can be called from any context.
+    *************************************************************/
+    void Load_IdleEnter(void);
+
+
+    /************************************************************
+    * Load_IdleExit
+    * Ends the idle interval (ignored if not idle).
+    * It can be called from any context.
+    *************************************************************/
+    void Load_IdleExit(void);
+
+
+    /************************************************************
+    * Load_Get1s
+    * Returns the load of the last 1-second window (permille).
+    *************************************************************/
+    uint16_t Load_Get1s(void);
+
+
+    /************************************************************
+    * Load_Get10s
+    * Returns the load of the last 10 seconds (permille).
+    *************************************************************/
+    uint16_t Load_Get10s(void);
+
+
+    /************************************************************
+    * Load_GetPeak
+    * Returns the highest 1-second load since the Load_Init()
+    * or the Load_ResetPeak() (permille).
+    *************************************************************/
+    uint16_t Load_GetPeak(void);
+
+
+    /************************************************************
+    * Load_ResetPeak
+    * Clears the peak load.
+    *************************************************************/
+    void Load_ResetPeak(void);
+
+
+    /************************************************************
+    * LOAD_TickedExecutor
+    * Closes the 1-second window and updates the loads.
+    * This function must be called from the BSP_Main every
+    * ticked interval.
+    *************************************************************/
+    inline void LOAD_TickedExecutor(void);
+
+#endif // __BSP_LOAD_H__
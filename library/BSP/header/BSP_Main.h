@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  17 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __BSP_MAIN_H__
@@ -15,6 +15,36 @@
     #include <BSP_Beep.h>
     #include <BSP_Adc.h>
     #include <BSP_LedBlink.h>
+    #include <BSP_LedDim.h>
+    #include <BSP_Profile.h>
+    #include <BSP_Load.h>
+    #include <BSP_Dispatch.h>
+
+    /*******************************************************
+     * Maximum number of ticks returned by BSP_GetIdleTicks().
+     * The ADC change detection has no idle information, the
+     * default equals its default changed interval.
+     *******************************************************/
+    #ifndef BSP_IDLE_MAX_TICKS
+        #define BSP_IDLE_MAX_TICKS  100
+    #endif
+
+    /*******************************************************
+     * PENDING WORK OF THE BSP_Executor (bit numbers)
+     * The bits are set by the ISRs (or found by a cheap check
+     * of the module), the BSP_Executor dispatches only the
+     * works of the set bits, lowest bit first.
+     *******************************************************/
+    #define BSP_WORK_TICK       0   // A system tick is pending (ticked executors and switch events).
+    #define BSP_WORK_DISPATCH   1   // Posted callbacks (one per pass, see the BSP_Dispatch.h).
+    #define BSP_WORK_COUNT      2   // Number of works.
+
+    /*******************************************************
+     * Idle mode of the BSP_Idle() (0: disabled, busy loop)
+     *******************************************************/
+    #ifndef BSP_IDLE_ENABLE
+        #define BSP_IDLE_ENABLE     1
+    #endif
 
     /*******************************************************
      * BSP_TickIsrExecutor (extern)
@@ -23,11 +53,52 @@
      *******************************************************/
     extern inline void BSP_TickIsrExecutor (void);
 
+    /*******************************************************
+     * BSP_TickIsrAddTicks
+     * Adds ticks that were not signaled by the system ticker,
+     * e.g. the ticks suppressed by the tickless idle. They are
+     * executed one by one by the BSP_Executor().
+     * Parameter:
+     * - ticks: Number of ticks.
+     *******************************************************/
+    void BSP_TickIsrAddTicks(uint16_t ticks);
+
+    /*******************************************************
+     * BSP_GetIdleTicks
+     * Returns the number of ticks the system ticker can be
+     * stopped without delaying the BSP (0: not idle).
+     *******************************************************/
+    uint16_t BSP_GetIdleTicks(void);
+
+    /*******************************************************
+     * BSP_GetPending
+     * Returns the bit mask of the pending works (BSP_WORK_x).
+     *******************************************************/
+    uint16_t BSP_GetPending(void);
+
     /*******************************************************
      * BSP_Executor
-     * Performs all executors.
+     * Polls the UART executors and performs the executors of
+     * the pending works. The received bytes of the UARTs are
+     * not pending works, they are taken by the call after the
+     * receive interrupt (that also wakes the BSP_Idle()).
      * This function must be called by the main infinite loop.
      *******************************************************/
     inline void BSP_Executor(void);
 
+    /*******************************************************
+     * BSP_Idle
+     * Enters the Idle mode of the CPU if no work is pending.
+     * Any interrupt wakes the CPU, the pending works are
+     * checked with the interrupts masked, so a work set just
+     * before the Idle mode is not missed.
+     * It is called by the main infinite loop of the Pure-BSP
+     * and BSP+RTL systems (see the System_Start in the ecc.h).
+     * Parameter:
+     * - is_pending: Returns true if any work of the system is
+     *   pending, e.g. the BSP and the RTL. NULL: Only the
+     *   BSP_GetPending() is checked.
+     *******************************************************/
+    void BSP_Idle(bool (*is_pending)(void));
+
 #endif // __BSP_MAIN_H__
@@ -0,0 +1,131 @@
+/************************************************************
+ * File:    BSP_Profile.h                                   *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __BSP_PROFILE_H__
+
+    #define __BSP_PROFILE_H__
+
+    #include <BSP_Clock.h>
+
+    /*******************************************************
+     * EXECUTION PROFILER
+     * The PROFILE_BEGIN() and PROFILE_END() stamp the Timer5
+     * (BSP_Clock) around a code section, the execution time
+     * is recorded into the statistic slot of the site. The
+     * time is in timer counts of CLOCK_PRESCALE instruction
+     * cycles (define the CLOCK_PRESCALE 1 for the cycles).
+     * A section must be shorter than 65536 counts (4.096mS
+     * or 32.768mS), a site must not be re-entered.
+     * All hooks are compiled out if the BSP_PROFILE_ENABLE
+     * (BSP_Config.h) is 0.
+     *******************************************************/
+
+    /*******************************************************
+     * Number of sites for the application
+     *******************************************************/
+    #ifndef PROFILE_USER_SITES
+        #define PROFILE_USER_SITES          4
+    #endif
+
+    /*******************************************************
+     * Profiling sites
+     *******************************************************/
+    #define PROFILE_SITE_TICK_ISR           0   // _T1Interrupt (ecc.c).
+    #define PROFILE_SITE_BSP_TICK_ISR       1   // BSP_TickIsrExecutor.
+    #define PROFILE_SITE_RTL_TICK_ISR       2   // RTL_TickIsrExecutor.
+    #define PROFILE_SITE_UART_EXECUTOR      3   // Uart1_Executor and Uart2_Executor.
+    #define PROFILE_SITE_PSW_TICKED         4   // PSW_KeyTickedExecutor.
+    #define PROFILE_SITE_LED_BLINK_TICKED   5   // LED_BlinkTickedExecutor.
+    #define PROFILE_SITE_LED_DIM_TICKED     6   // LED_DimTickedExecutor.
+    #define PROFILE_SITE_BEEP_TICKED        7   // BEEP_TickedExecutor.
+    #define PROFILE_SITE_ADC_TICKED         8   // ADC_TickedExecutor.
+    #define PROFILE_SITE_DISPATCH           9   // Dispatch_Executor (posted callbacks).
+    #define PROFILE_SITE_USER               10  // First site of the application.
+    #define PROFILE_MAX_SITES               (PROFILE_SITE_USER + PROFILE_USER_SITES)
+
+    /*******************************************************
+     * PROFILE STATISTIC STRUCTURE
+     *******************************************************/
+    typedef struct {
+        uint32_t    count;      // Number of executions.
+        uint32_t    sum;        // Sum of the execution times (for the average).
+        uint16_t    samples;    // Number of the executions in the sum.
+        uint16_t    min;        // Minimum execution time (counts).
+        uint16_t    max;        // Maximum execution time (counts).
+    }profile_stat_t;
+
+
+    #if BSP_PROFILE_ENABLE > 0
+
+        /*******************************************************
+         * Timer counts at the beginning of the sites
+         *******************************************************/
+        extern volatile uint16_t profile_begins[PROFILE_MAX_SITES];
+
+        #define PROFILE_BEGIN(site)     (profile_begins[(site)] = CLOCK_STAMP_COUNTS())
+        #define PROFILE_END(site)       Profile_Record((site), CLOCK_STAMP_COUNTS() - profile_begins[(site)])
+
+
+        /************************************************************
+        * Profile_Init
+        * Clears the statistics and measures the overhead of the
+        * PROFILE_BEGIN()/PROFILE_END() pair, it is subtracted from
+        * every recorded time. The Clock_Init() must be called first.
+        *************************************************************/
+        void Profile_Init(void);
+
+
+        /************************************************************
+        * Profile_Record
+        * Records the execution time of the site (PROFILE_END).
+        * It can be called from any context, including ISRs.
+        * Parameters:
+        * - site: Id of the site (0 - PROFILE_MAX_SITES-1).
+        * - counts: Execution time (timer counts).
+        *************************************************************/
+        void Profile_Record(uint16_t site, uint16_t counts);
+
+
+        /************************************************************
+        * Profile_Get
+        * Copies the statistic of the site.
+        * Returns false if the site is invalid.
+        * Parameters:
+        * - site: Id of the site.
+        * - stat: Target statistic.
+        *************************************************************/
+        bool Profile_Get(uint16_t site, profile_stat_t *stat);
+
+
+        /************************************************************
+        * Profile_Reset
+        * Clears the statistics of all sites.
+        *************************************************************/
+        void Profile_Reset(void);
+
+
+        /************************************************************
+        * Profile_Dump
+        * Prints the statistics of the executed sites (count, min,
+        * max and average counts) to the UART1.
+        *************************************************************/
+        void Profile_Dump(void);
+
+    #else
+
+        #define PROFILE_BEGIN(site)
+        #define PROFILE_END(site)
+        #define Profile_Init()
+        #define Profile_Record(site, counts)
+        #define Profile_Get(site, stat)     false
+        #define Profile_Reset()
+        #define Profile_Dump()
+
+    #endif
+
+#endif // __BSP_PROFILE_H__
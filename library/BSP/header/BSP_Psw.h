@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  16 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 
@@ -33,6 +33,7 @@
      * PSW PORT
      *******************************************************/
     #define PSW_PORT        PORTB
+    #define PSW_PORT_SHIFT  4       // PSW0 is the bit 4 of the port (RB4-RB7).
 
     /*******************************************************
      * TRIS INPUT DIRECTION
@@ -55,6 +56,14 @@
     #define PSW2_PORT   PORTBbits.RB6
     #define PSW3_PORT   PORTBbits.RB7
 
+    /*******************************************************
+     * PSW INPUT CHANGE NOTIFICATION (CN) ENABLE BITS
+     *******************************************************/
+    #define PSW0_CNEN   CNEN1bits.CN1IE     // RB4: CN1
+    #define PSW1_CNEN   CNEN2bits.CN27IE    // RB5: CN27
+    #define PSW2_CNEN   CNEN2bits.CN24IE    // RB6: CN24
+    #define PSW3_CNEN   CNEN2bits.CN23IE    // RB7: CN23
+
     /*******************************************************
      * PSW GET MACROS
      *******************************************************/
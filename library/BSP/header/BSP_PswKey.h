@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  17 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 
@@ -12,6 +12,7 @@
     #define __BSP_PSW_KEY_H__
 
     #include <BSP_Psw.h>
+    #include <BSP_Clock.h>
 
     /******************************************************
      * STATES OF SWITCHES
@@ -23,6 +24,8 @@
     #define PSW_STATE_UP                1<<3    // 0x08: KEY_UP
 
     #define PSW_STATE_CHANGE            1<<4    // 0x10: Used for KeyChangedCallback only.
+    #define PSW_STATE_CLICK             1<<5    // 0x20: Used for KeyClickCallback only.
+    #define PSW_STATE_CHORD             1<<6    // 0x40: Used for ChordCallback only.
 
     /******************************************************
      * STATES TICKS
@@ -31,6 +34,23 @@
     #define PSW_DOWN_TO_HOLD_TICKS      1000    // Ticks for state DOWN->HOLD.
     #define PSW_HOLD_TO_PULSE_TICKS     2000    // Ticks for state HOLD->LOCK.
 
+    /******************************************************
+     * DEBOUNCING
+     * All switches are debounced together by a 2-bit vertical
+     * counter. A key changes after 4 equal samples, so the
+     * debouncing time is 4*PSW_DEBOUNCE_SAMPLE_TICKS.
+     ******************************************************/
+    #define PSW_DEBOUNCE_SAMPLE_TICKS   (PSW_STATE_CHANGED_TICKS/4) // Ticks between two samples of the PSW_PORT.
+
+    /******************************************************
+     * INPUT CHANGE NOTIFICATION (CN)
+     * When all keys are released and debounced, the executor
+     * stops sampling and waits for the CN interrupt of RB4-RB7.
+     ******************************************************/
+    #ifndef PSW_CN_ISR_PRIORITY
+        #define PSW_CN_ISR_PRIORITY     1       // Interrupt priority of the CN (it can wake the tickless idle).
+    #endif
+
     /******************************************************
      * KEY HOLDING EMITTING TICKS
      ******************************************************/
@@ -38,6 +58,37 @@
     #define PSW_PULSE_MIN_TICKS         50      // Ticks for minimum interval of KEY_LOCK callback emitting.
     #define PSW_PULSE_DEC_TICKS         5       // Tick for interval decreasing step.
 
+    /******************************************************
+     * MULTI-CLICK AND CHORD TICKS
+     ******************************************************/
+    #define PSW_CLICK_GAP_TICKS         300     // Maximum ticks between the release and the next press of a multi-click.
+    #define PSW_CHORD_TICKS             100     // Maximum ticks between the presses of the keys of a chord.
+
+    /******************************************************
+     * KEY TIMING STRUCTURE
+     * The timing can be changed per key at runtime, see the
+     * Psw_SetTiming(). A zero click_ticks or chord_ticks
+     * disables the multi-click or chord detection of the key.
+     ******************************************************/
+    typedef struct {
+        uint16_t    hold_ticks;                 // Ticks for state DOWN->HOLD.
+        uint16_t    lock_ticks;                 // Ticks for state HOLD->LOCK.
+        uint16_t    pulse_max_ticks;            // Starting interval of the KEY_LOCK callback emitting.
+        uint16_t    pulse_min_ticks;            // Minimum interval of the KEY_LOCK callback emitting.
+        uint16_t    pulse_dec_ticks;            // Interval decreasing step.
+        uint16_t    click_ticks;                // Maximum gap between the clicks.
+        uint16_t    chord_ticks;                // Maximum delay between the keys of a chord.
+    }psw_timing_t;
+
+    /******************************************************
+     * Initializer of the default key timing
+     ******************************************************/
+    #define PSW_TIMING_DEFAULT {                                            \
+        PSW_DOWN_TO_HOLD_TICKS, PSW_HOLD_TO_PULSE_TICKS,                    \
+        PSW_PULSE_MAX_TICKS, PSW_PULSE_MIN_TICKS, PSW_PULSE_DEC_TICKS,      \
+        PSW_CLICK_GAP_TICKS, PSW_CHORD_TICKS                                \
+    }
+
 
     /*******************************************************
      * SWITCH EVENT TYPES
@@ -66,6 +117,12 @@
         bool        changed;                    // Key state changed flag used to signal the callback emitter.
         uint8_t     callback_flags;             // Callback flags used to indicate the available callback functions.
 
+        callback_t  click_callback;             // KeyClick callback function.
+        const psw_timing_t *timing;             // Key timing (NULL: default timing).
+        uint8_t     clicks;                     // Number of the clicks of the current multi-click.
+        uint8_t     clicked;                    // Number of the clicks to be emitted.
+        bool        chorded;                    // The key is a part of a chord.
+
     }switch_t;
 
 
@@ -78,6 +135,9 @@
         uint16_t    state;                      // State of the switch.
         char        *sname;                     // State name of the switch.
         switch_t    *sender;                    // Switch object.
+        uint16_t    clicks;                     // Number of clicks (KEY_CLICK).
+        uint8_t     keys;                       // Keys pressed together (KEY_CHORD), or all pressed keys.
+        uint32_t    timestamp;                  // Time of the debounced edge (in uS, Clock_GetMicros).
     }switch_event_t;
 
     /******************************************************
@@ -135,13 +195,86 @@
     bool Psw_SetKeyChangedCallback(int16_t id, callback_t callback);
 
 
+    /******************************************************
+     * Psw_SetKeyClickCallback
+     * Sets/Adds KeyClick callback to the switch specified by the id.
+     * The callback is called when no new press follows the last
+     * short press within the click_ticks of the key timing.
+     * The number of clicks (1: single, 2: double, 3: triple, ...)
+     * is given in the clicks field of the switch event.
+     * Retuens false if the operation failed.
+     * Parameter:
+     * - id: Id of the target switch (PSW_ID_0, PSW_ID_1, PSW_ID_2, PSW_ID_3).
+     * - callback: Callback function to execute when the KeyClick is detected.
+     ******************************************************/
+    bool Psw_SetKeyClickCallback(int16_t id, callback_t callback);
+
+
+    /******************************************************
+     * Psw_SetChordCallback
+     * Sets the chord callback of all switches. The callback is
+     * called when a key is pressed within the chord_ticks after
+     * another key that is still down. The pressed keys are given
+     * in the keys field of the switch event. Keys of a chord do
+     * not produce KeyClick events.
+     * Parameter:
+     * - callback: Callback function to execute when a chord is detected.
+     ******************************************************/
+    void Psw_SetChordCallback(callback_t callback);
+
+
+    /******************************************************
+     * Psw_SetTiming
+     * Sets the timing of the switch specified by the id.
+     * The timing is not copied, it must be kept (e.g. const).
+     * Retuens false if the operation failed.
+     * Parameter:
+     * - id: Id of the target switch (PSW_ID_0, PSW_ID_1, PSW_ID_2, PSW_ID_3).
+     * - timing: Timing of the key, NULL for the default timing.
+     ******************************************************/
+    bool Psw_SetTiming(int16_t id, const psw_timing_t *timing);
+
+
+    /******************************************************
+     * Psw_SetEventHook
+     * Sets a hook called with every switch event before its
+     * callback is posted, e.g. to post the event to an RTOS
+     * queue. It is called by the PSW_KeyTickedExecutor, so it
+     * must be short and must not block.
+     * Parameter:
+     * - hook: Hook function, the argument is the switch_event_t.
+     ******************************************************/
+    void Psw_SetEventHook(callback_t hook);
+
+
+    /******************************************************
+     * Psw_GetDroppedEvents
+     * Returns the number of events dropped because the queue
+     * of the dispatcher (BSP_Dispatch) was full.
+     ******************************************************/
+    uint16_t Psw_GetDroppedEvents(void);
+
+
+    /******************************************************
+     * Psw_IsIdle
+     * Returns true if all keys are released and the switches
+     * are waiting for the CN interrupt (no tick is needed).
+     ******************************************************/
+    bool Psw_IsIdle(void);
+
+
     /************************************************************
      * PSW_KeyTickedExecutor
-     * Performs callback functions.
+     * Debounces all switches, passes the switch events to the
+     * hook and posts their callbacks to the dispatcher.
+     * Only the keys that changed or are not in the KEY_OFF
+     * state are processed by the state machine. When all keys
+     * are OFF, it returns immediately until the CN interrupt.
      * This function must be called from the BSP_Main every ticked interval.
      *********************************************************/
     inline void PSW_KeyTickedExecutor(void);
 
 
 
+
 #endif // __BSP_PSW_KEY_H__
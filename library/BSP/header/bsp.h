@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  18 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __BPS_H__
@@ -21,5 +21,10 @@
     #include <BSP_Adc.h>
     #include <BSP_PswKey.h>
     #include <BSP_LedBlink.h>
+    #include <BSP_LedDim.h>
     #include <BSP_System.h>
+    #include <BSP_Clock.h>
+    #include <BSP_Profile.h>
+    #include <BSP_Load.h>
+    #include <BSP_Dispatch.h>
 #endif
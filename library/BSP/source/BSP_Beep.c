@@ -0,0 +1,453 @@
+/************************************************************
+ * File:    BSP_Beep.c                                      *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_Beep.h>
+#include <BSP_Uart.h>
+#include <BSP_Dispatch.h>
+
+/*******************************************************
+ * Sequencer phases
+ *******************************************************/
+#define BEEP_PHASE_SOUND    0       // The note is sounding.
+#define BEEP_PHASE_REST     1       // Silent interval after the note.
+
+/*******************************************************
+ * NOTE SEQUENCER STRUCTURE
+ *******************************************************/
+typedef struct {
+    beep_note_t         queue[BEEP_QUEUE_LENGTH];   // Note queue.
+    volatile uint16_t   put;                        // Put index (written by the producer only).
+    volatile uint16_t   get;                        // Get index (written by the executor only).
+    const beep_note_t   *melody;                    // Melody table being played.
+    uint16_t            length;                     // Remaining notes of the melody.
+    uint16_t            ticks;                      // Ticks to the next edge.
+    uint16_t            rest;                       // Rest interval of the current note.
+    uint16_t            phase;                      // Sequencer phase.
+    volatile bool       active;                     // Sequencer is running.
+}beep_sequencer_t;
+
+/*******************************************************
+ * Beep object and note sequencer
+ *******************************************************/
+static beep_t           __beep;
+static beep_sequencer_t __sequencer;
+
+/*******************************************************
+ * Number of events dropped by the dispatcher (BSP_Dispatch)
+ *******************************************************/
+static uint16_t         __beep_dropped;
+
+/*******************************************************
+ * Prescalers of the Timer3 and the lowest frequency of
+ * each prescaler (FCY/prescaler/65536)
+ *******************************************************/
+static const uint16_t __prescalers[] = { 1, 8, 64, 256 };
+static const float    __min_freqs[]  = { 244.140625, 30.517578, 3.814697, 0.953674 };
+
+/*******************************************************
+ * Integer version of the tables above, the Timer3 clock
+ * of each prescaler and the lowest frequency in Hz.
+ *******************************************************/
+static const uint32_t __prescaler_clocks[] = { FCY/1, FCY/8, FCY/64, FCY/256 };
+static const uint16_t __min_hz[]           = { 245, 31, 4, 1 };
+
+
+/************************************************************
+ * Beep_Init
+ ************************************************************/
+void Beep_Init(void) {
+
+    T3CONbits.TCKPS  = 0;       // Prescaler 1:1
+    T3CONbits.TCS    = 0;       // Internal clock (FCY)
+    T3CONbits.TGATE  = 0;       // Gated time accumulation disabled
+    T3CONbits.TON    = 0;       // Stopped
+    PR3              = 0;
+    IEC0bits.T3IE    = 0;       // No interrupt
+
+    OC5R             = 0;       // Rising edge
+    OC5RS            = PR3>>1;  // Falling edge
+    OC5CONbits.OCM   = 5;       // Continuous pulse mode
+    OC5CONbits.OCTSEL= 1;       // Timer3 is the time base
+
+    Mcu_UnLockRemap();
+    RPOR5bits.RP11R  = 22;      // OC5 -> RP11
+    Mcu_LockRemap();
+
+    __beep.interval  = 200;
+    __beep.status    = BEEP_OFF;
+    __beep.ticks     = 0;
+    __beep.callback  = NULL;
+    __beep.counter   = 0;
+
+    memset(&__sequencer, 0, sizeof(__sequencer));
+    __beep_dropped   = 0;
+
+    Beep_SetPowerPermille(BEEP_POWER_MAX);
+    Beep_SetFrequencyHz(500);
+}
+
+
+/************************************************************
+ * __beep_set_period
+ * Writes the prescaler and period of the Timer3 and updates
+ * the duty of the OC5 from the precomputed power scale.
+ ************************************************************/
+static void __beep_set_period(uint16_t prescaler, uint16_t period) {
+    T3CONbits.TCKPS = prescaler;
+    PR3             = period;
+    OC5RS           = (uint16_t)(__builtin_muluu(period, __beep.scale) >> 16);
+}
+
+
+/************************************************************
+ * Beep_SetFrequency
+ ************************************************************/
+void Beep_SetFrequency(float freq) {
+
+    uint16_t idx;
+    float    prv;
+
+    if( freq < 1.0 ) {
+        freq = 1.0;
+    }
+    if( freq > 160000.0 ) {
+        freq = 160000.0;
+    }
+
+    for( idx = 0; idx < 3; idx++ ) {
+        if( freq >= __min_freqs[idx] ) {
+            break;
+        }
+    }
+
+    prv = ((float)FCY / __prescalers[idx]) / freq + 0.5;
+    if( prv > 65535.0 ) {
+        Uart1_Printf("Overflow, prv: %f > 65535\r\n", prv);
+    }
+
+    __beep_set_period(idx, (uint16_t)prv);
+    __beep.frequency = (freq < 65535.0) ? (uint16_t)(freq + 0.5) : 65535;
+}
+
+
+/************************************************************
+ * Beep_SetFrequencyHz
+ ************************************************************/
+void Beep_SetFrequencyHz(uint16_t frequency) {
+
+    uint16_t idx;
+
+    if( frequency < 1 ) {
+        frequency = 1;
+    }
+
+    for( idx = 0; idx < 3; idx++ ) {
+        if( frequency >= __min_hz[idx] ) {
+            break;
+        }
+    }
+
+    // 32/16 hardware division, the quotient always fits the PR3.
+    __beep_set_period(idx, __builtin_divud(__prescaler_clocks[idx] + (frequency>>1), frequency));
+    __beep.frequency = frequency;
+}
+
+
+/************************************************************
+ * Beep_SetPower
+ ************************************************************/
+void Beep_SetPower(float power) {
+    if( power < 0.0 ) {
+        power = 0.0;
+    }
+    if( power > 1.0 ) {
+        power = 1.0;
+    }
+    Beep_SetPowerPermille((uint16_t)(power * BEEP_POWER_MAX + 0.5));
+}
+
+
+/************************************************************
+ * Beep_SetPowerPermille
+ ************************************************************/
+void Beep_SetPowerPermille(uint16_t power) {
+    if( power > BEEP_POWER_MAX ) {
+        power = BEEP_POWER_MAX;
+    }
+    __beep.power = power;
+    __beep.scale = __builtin_divud((uint32_t)power << 15, BEEP_POWER_MAX);
+    OC5RS        = (uint16_t)(__builtin_muluu(PR3, __beep.scale) >> 16);
+}
+
+
+/************************************************************
+ * Beep
+ ************************************************************/
+void Beep(uint16_t interval) {
+    __beep.interval = interval;
+    __beep.status   = BEEP_ON;
+    __beep.ticks    = 0;
+    T3CONbits.TON   = 1;
+    __beep.counter++;
+}
+
+
+/************************************************************
+ * Beep_Play
+ ************************************************************/
+void Beep_Play(float frequency, uint16_t interval) {
+    Beep_SetFrequency(frequency);
+    Beep(interval);
+}
+
+
+/************************************************************
+ * Beep_PlayHz
+ ************************************************************/
+void Beep_PlayHz(uint16_t frequency, uint16_t interval) {
+    Beep_SetFrequencyHz(frequency);
+    Beep(interval);
+}
+
+
+/************************************************************
+ * Beep_SetCallback
+ ************************************************************/
+void Beep_SetCallback(callback_t callback) {
+    __beep.callback = callback;
+}
+
+
+/************************************************************
+ * __beep_off
+ * Turns the beep sound off.
+ ************************************************************/
+static void __beep_off(void) {
+    T3CONbits.TON = 0;
+    __beep.status = BEEP_OFF;
+}
+
+
+/************************************************************
+ * __beep_emit
+ * Posts the callback function with the given event type.
+ * The float fields of the event are only computed here.
+ ************************************************************/
+static void __beep_emit(int type) {
+    beep_event_t evt;
+    if( __beep.callback != NULL ) {
+        evt.type      = type;
+        evt.interval  = __beep.interval;
+        evt.counter   = __beep.counter;
+        evt.frequency = __beep.frequency;
+        evt.power     = __beep.power * 0.001;
+        evt.sender    = &__beep;
+        if( !Dispatch_Post(__beep.callback, &evt, sizeof(evt)) ) {
+            __beep_dropped++;
+        }
+    }
+}
+
+
+/************************************************************
+ * __beep_sequencer_start
+ * Starts the sequencer if it is not running.
+ * The first note is loaded at the next tick.
+ ************************************************************/
+static void __beep_sequencer_start(void) {
+    if( !__sequencer.active ) {
+        __sequencer.phase  = BEEP_PHASE_REST;
+        __sequencer.rest   = 0;
+        __sequencer.ticks  = 1;
+        __sequencer.active = true;
+    }
+}
+
+
+/************************************************************
+ * __beep_sequencer_pop
+ * Takes the next note, the melody first, then the queue.
+ * The sequencer is deactivated when there is no note left.
+ * It must be called in the critical section.
+ ************************************************************/
+static bool __beep_sequencer_pop(beep_note_t *note) {
+    if( __sequencer.length > 0 ) {
+        *note = *__sequencer.melody++;
+        __sequencer.length--;
+        return true;
+    }
+    if( __sequencer.get != __sequencer.put ) {
+        *note = __sequencer.queue[__sequencer.get];
+        __sequencer.get = (__sequencer.get + 1) % BEEP_QUEUE_LENGTH;
+        return true;
+    }
+    __sequencer.active = false;
+    return false;
+}
+
+
+/************************************************************
+ * __beep_sequencer_edge
+ * Performs the sequencer transition (note -> rest -> note).
+ ************************************************************/
+static void __beep_sequencer_edge(void) {
+
+    beep_note_t note;
+    bool        next;
+
+    /*********************************
+     * Note -> Rest
+     *********************************/
+    if( __sequencer.phase == BEEP_PHASE_SOUND && __sequencer.rest > 0 ) {
+        __beep_off();
+        __sequencer.phase = BEEP_PHASE_REST;
+        __sequencer.ticks = __sequencer.rest;
+        return;
+    }
+
+    /*********************************
+     * Next note
+     *********************************/
+    PERFORM_CRITICAL_SECTION( next = __beep_sequencer_pop(&note) );
+    if( next ) {
+        __sequencer.phase = BEEP_PHASE_SOUND;
+        __sequencer.rest  = note.rest;
+        __sequencer.ticks = (note.duration > 0) ? note.duration : 1;
+        if( note.frequency > 0 ) {
+            if( note.power != __beep.power ) {
+                Beep_SetPowerPermille(note.power);
+            }
+            Beep_SetFrequencyHz(note.frequency);
+            __beep.interval = note.duration;
+            __beep.status   = BEEP_ON;
+            T3CONbits.TON   = 1;
+            __beep.counter++;
+        }
+        else {
+            __beep_off();
+        }
+        return;
+    }
+
+    /*********************************
+     * End of the sequence
+     *********************************/
+    __beep_off();
+    __beep.ticks = 0;
+    __beep_emit(EVT_BEEP_SEQUENCE_END);
+}
+
+
+/************************************************************
+ * Beep_Enqueue
+ ************************************************************/
+bool Beep_Enqueue(uint16_t frequency, uint16_t duration, uint16_t power, uint16_t rest) {
+
+    uint16_t     put  = __sequencer.put;
+    uint16_t     next = (put + 1) % BEEP_QUEUE_LENGTH;
+    beep_note_t *note = &__sequencer.queue[put];
+
+    if( next == __sequencer.get ) {
+        return false;   // The queue is full.
+    }
+
+    note->frequency = frequency;
+    note->duration  = duration;
+    note->power     = power;
+    note->rest      = rest;
+    __sequencer.put = next;
+
+    PERFORM_CRITICAL_SECTION( __beep_sequencer_start() );
+    return true;
+}
+
+
+/************************************************************
+ * Beep_PlayMelody
+ ************************************************************/
+void Beep_PlayMelody(const beep_note_t *melody, uint16_t length) {
+    PERFORM_CRITICAL_SECTION( {
+        __sequencer.melody = melody;
+        __sequencer.length = length;
+        __beep_sequencer_start();
+    } );
+}
+
+
+/************************************************************
+ * Beep_Stop
+ ************************************************************/
+void Beep_Stop(void) {
+    PERFORM_CRITICAL_SECTION( {
+        __sequencer.length = 0;
+        __sequencer.get    = __sequencer.put;
+        __sequencer.active = false;
+        __beep.ticks       = 0;
+        __beep_off();
+    } );
+}
+
+
+/************************************************************
+ * Beep_IsBusy
+ ************************************************************/
+bool Beep_IsBusy(void) {
+    return __sequencer.active;
+}
+
+
+/************************************************************
+ * Beep_GetIdleTicks
+ ************************************************************/
+uint16_t Beep_GetIdleTicks(void) {
+    if( __sequencer.active ) {
+        return __sequencer.ticks;
+    }
+    // The end of the interval is signaled even if the beep is off.
+    if( __beep.status == BEEP_ON || __beep.callback != NULL ) {
+        return (__beep.ticks < __beep.interval) ? (__beep.interval - __beep.ticks + 1) : 1;
+    }
+    return 0xFFFF;
+}
+
+
+/************************************************************
+ * Beep_GetDroppedEvents
+ ************************************************************/
+uint16_t Beep_GetDroppedEvents(void) {
+    return __beep_dropped;
+}
+
+
+/************************************************************
+ * BEEP_TickedExecutor
+ ************************************************************/
+inline void BEEP_TickedExecutor(void) {
+
+    /*********************************
+     * Note sequencer, only the tick
+     * counter is touched between edges.
+     *********************************/
+    if( __sequencer.active ) {
+        if( --__sequencer.ticks == 0 ) {
+            __beep_sequencer_edge();
+        }
+        return;
+    }
+
+    /*********************************
+     * Single beep
+     *********************************/
+    if( __beep.ticks++ < __beep.interval ) {
+        return;
+    }
+    __beep.ticks = 0;
+
+    __beep_emit(EVT_BEEP_END);
+    __beep_off();
+}
@@ -0,0 +1,87 @@
+/************************************************************
+ * File:    BSP_Clock.c                                     *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_Clock.h>
+
+/*******************************************************
+ * Number of overflows of the Timer5 (upper 32 bits)
+ *******************************************************/
+static volatile uint32_t __overflows;
+
+
+/************************************************************
+ * Clock_Init
+ ************************************************************/
+void Clock_Init(void) {
+
+    T5CONbits.TON   = 0;        // Stopped
+    T5CONbits.TCS   = 0;        // Internal clock (FCY)
+    T5CONbits.TGATE = 0;        // Gated time accumulation disabled
+    T5CONbits.TSIDL = 0;        // Continue in the Idle mode
+    #if CLOCK_PRESCALE == 1
+        T5CONbits.TCKPS = 0;    // Prescaler 1:1
+    #else
+        T5CONbits.TCKPS = 1;    // Prescaler 1:8
+    #endif
+    TMR5            = 0;
+    PR5             = 0xFFFF;   // Free-running
+    __overflows     = 0;
+
+    IPC7bits.T5IP   = CLOCK_ISR_PRIORITY;
+    IFS1bits.T5IF   = 0;
+    IEC1bits.T5IE   = 1;
+    T5CONbits.TON   = 1;
+}
+
+
+/************************************************************
+ * __clock_read
+ * Reads the overflow counter and the timer count coherently.
+ * An overflow that is not yet counted by the ISR is added,
+ * the TMR5 has already wrapped when the T5IF is set.
+ ************************************************************/
+static void __clock_read(uint32_t *high, uint16_t *low) {
+    PERFORM_CRITICAL_SECTION( {
+        *low  = TMR5;
+        *high = __overflows;
+        if( IFS1bits.T5IF && *low < 0x8000 ) {
+            (*high)++;
+        }
+    } );
+}
+
+
+/************************************************************
+ * Clock_GetCounts
+ ************************************************************/
+uint32_t Clock_GetCounts(void) {
+    uint32_t high;
+    uint16_t low;
+    __clock_read(&high, &low);
+    return (high << 16) | low;
+}
+
+
+/************************************************************
+ * Clock_GetMicros
+ ************************************************************/
+uint32_t Clock_GetMicros(void) {
+    uint32_t high;
+    uint16_t low;
+    __clock_read(&high, &low);
+    return (high << (16 - CLOCK_US_SHIFT)) | (low >> CLOCK_US_SHIFT);
+}
+
+
+/************************************************************
+ * Timer5 Interrupt Service Routine (overflow counter)
+ ************************************************************/
+void __attribute__((interrupt, auto_psv)) _T5Interrupt(void) {
+    __overflows++;
+    IFS1bits.T5IF = 0;
+}
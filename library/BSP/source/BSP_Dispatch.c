@@ -0,0 +1,276 @@
+/************************************************************
+ * File:    BSP_Dispatch.c                                  *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_Dispatch.h>
+
+/*******************************************************
+ * Size of the event copy in words (the events contain
+ * word data, they must be word aligned)
+ *******************************************************/
+#define DISPATCH_EVENT_WORDS    ((DISPATCH_EVENT_SIZE + 1) / 2)
+
+/*******************************************************
+ * End of a list of the slots
+ *******************************************************/
+#define DISPATCH_NONE   0xFF
+
+/*******************************************************
+ * POSTED CALLBACK STRUCTURE (slot)
+ *******************************************************/
+typedef struct {
+    callback_t  callback;                       // Callback function.
+    uint8_t     next;                           // Next slot of the list.
+    uint8_t     stat;                           // Index of the statistic (DISPATCH_MAX_CALLBACKS: shared).
+    uint16_t    event[DISPATCH_EVENT_WORDS];    // Copy of the event (word aligned).
+}dispatch_slot_t;
+
+/*******************************************************
+ * Dispatcher objects
+ * - __slots:   Posted callbacks, linked into the free list
+ *              and one FIFO list per priority.
+ * - __pending: Bit mask of the non-empty priorities, bit 0
+ *              is the highest priority (found by the ff1).
+ * - __stats:   Registered callbacks, the last object is
+ *              shared by the unregistered callbacks.
+ *******************************************************/
+static dispatch_slot_t      __slots[DISPATCH_QUEUE_LENGTH];
+static uint8_t              __free;
+static uint8_t              __head[DISPATCH_PRIORITIES];
+static uint8_t              __tail[DISPATCH_PRIORITIES];
+static volatile uint16_t    __pending;
+static dispatch_stat_t      __stats[DISPATCH_MAX_CALLBACKS + 1];
+static uint8_t              __registered;
+static uint16_t             __dropped;
+static callback_t           __overrun_callback;
+
+/*******************************************************
+ * Bit of the priority in the __pending
+ *******************************************************/
+#define DISPATCH_BIT(priority)  (DISPATCH_PRIORITIES - 1 - (priority))
+
+
+/************************************************************
+ * Dispatch_Init
+ ************************************************************/
+void Dispatch_Init(void) {
+    uint8_t i;
+    PERFORM_CRITICAL_SECTION( {
+        for( i = 0; i < DISPATCH_QUEUE_LENGTH; i++ ) {
+            __slots[i].next = i + 1;
+        }
+        __slots[DISPATCH_QUEUE_LENGTH - 1].next = DISPATCH_NONE;
+        __free = 0;
+        for( i = 0; i < DISPATCH_PRIORITIES; i++ ) {
+            __head[i] = DISPATCH_NONE;
+            __tail[i] = DISPATCH_NONE;
+        }
+        __pending = 0;
+    } );
+    memset(__stats, 0, sizeof(__stats));
+    __stats[DISPATCH_MAX_CALLBACKS].priority  = DISPATCH_PRIORITY_NORMAL;
+    __stats[DISPATCH_MAX_CALLBACKS].budget_us = DISPATCH_DEFAULT_BUDGET_US;
+    __registered       = 0;
+    __dropped          = 0;
+    __overrun_callback = NULL;
+}
+
+
+/************************************************************
+ * __dispatch_find
+ * Returns the index of the statistic of the callback.
+ ************************************************************/
+static uint8_t __dispatch_find(callback_t callback) {
+    uint8_t i;
+    for( i = 0; i < __registered; i++ ) {
+        if( __stats[i].callback == callback ) {
+            return i;
+        }
+    }
+    return DISPATCH_MAX_CALLBACKS;
+}
+
+
+/************************************************************
+ * Dispatch_Register
+ ************************************************************/
+bool Dispatch_Register(callback_t callback, uint8_t priority, uint32_t budget_us) {
+
+    uint8_t idx = __dispatch_find(callback);
+
+    if( callback == NULL || priority >= DISPATCH_PRIORITIES ) {
+        return false;
+    }
+    if( idx == DISPATCH_MAX_CALLBACKS ) {
+        if( __registered >= DISPATCH_MAX_CALLBACKS ) {
+            return false;
+        }
+        idx = __registered;
+        memset(&__stats[idx], 0, sizeof(dispatch_stat_t));
+        __stats[idx].callback = callback;
+    }
+    __stats[idx].priority  = priority;
+    __stats[idx].budget_us = budget_us;
+    // The table is searched by the Dispatch_Post() in ISRs.
+    PERFORM_CRITICAL_SECTION( {
+        if( idx == __registered ) {
+            __registered++;
+        }
+    } );
+    return true;
+}
+
+
+/************************************************************
+ * __dispatch_call
+ * Performs the callback and updates its statistic.
+ ************************************************************/
+static void __dispatch_call(uint8_t idx, callback_t callback, void *evt) {
+
+    dispatch_stat_t *stat = &__stats[idx];
+    uint32_t         begin, elapsed;
+
+    begin = Clock_GetMicros();
+    callback(evt);
+    elapsed = Clock_GetMicros() - begin;
+
+    stat->calls++;
+    stat->last_us = elapsed;
+    if( elapsed > stat->max_us ) {
+        stat->max_us = elapsed;
+    }
+    stat->overrun = (stat->budget_us > 0 && elapsed > stat->budget_us);
+    if( stat->overrun ) {
+        stat->overruns++;
+        if( __overrun_callback != NULL ) {
+            __overrun_callback(stat);
+        }
+    }
+}
+
+
+/************************************************************
+ * Dispatch_Post
+ ************************************************************/
+bool Dispatch_Post(callback_t callback, const void *evt, uint16_t size) {
+
+    dispatch_slot_t *slot;
+    uint8_t          idx, stat, prio, bit;
+    bool             posted = false;
+
+    if( callback == NULL ) {
+        return false;
+    }
+    stat = __dispatch_find(callback);
+    prio = __stats[stat].priority;
+    bit  = DISPATCH_BIT(prio);
+
+    if( size <= DISPATCH_EVENT_SIZE ) {
+        PERFORM_CRITICAL_SECTION( {
+            idx = __free;
+            if( idx != DISPATCH_NONE ) {
+                slot           = &__slots[idx];
+                __free         = slot->next;
+                slot->callback = callback;
+                slot->stat     = stat;
+                slot->next     = DISPATCH_NONE;
+                memcpy(slot->event, evt, size);
+                if( __head[prio] == DISPATCH_NONE ) {
+                    __head[prio] = idx;
+                }
+                else {
+                    __slots[__tail[prio]].next = idx;
+                }
+                __tail[prio] = idx;
+                __pending   |= (1u << bit);
+                posted       = true;
+            }
+        } );
+    }
+
+    // The event is dropped, a direct call would bypass the priorities.
+    if( !posted ) {
+        PERFORM_CRITICAL_SECTION( {
+            if( __dropped < 0xFFFF ) {
+                __dropped++;
+            }
+        } );
+    }
+    return posted;
+}
+
+
+/************************************************************
+ * Dispatch_IsPending
+ ************************************************************/
+bool Dispatch_IsPending(void) {
+    return __pending != 0;
+}
+
+
+/************************************************************
+ * Dispatch_GetStat
+ ************************************************************/
+bool Dispatch_GetStat(callback_t callback, dispatch_stat_t *stat) {
+    uint8_t idx = (callback == NULL) ? DISPATCH_MAX_CALLBACKS : __dispatch_find(callback);
+    if( callback != NULL && idx == DISPATCH_MAX_CALLBACKS ) {
+        return false;
+    }
+    *stat = __stats[idx];
+    return true;
+}
+
+
+/************************************************************
+ * Dispatch_GetDropped
+ ************************************************************/
+uint16_t Dispatch_GetDropped(void) {
+    return __dropped;
+}
+
+
+/************************************************************
+ * Dispatch_SetOverrunCallback
+ ************************************************************/
+void Dispatch_SetOverrunCallback(callback_t callback) {
+    __overrun_callback = callback;
+}
+
+
+/************************************************************
+ * Dispatch_Executor
+ ************************************************************/
+inline void Dispatch_Executor(void) {
+
+    dispatch_slot_t *slot;
+    callback_t       callback;
+    uint16_t         event[DISPATCH_EVENT_WORDS];
+    uint8_t          idx, prio, stat;
+
+    if( __pending == 0 ) {
+        return;
+    }
+
+    // The slot is released before the call, the callback can post again.
+    PERFORM_CRITICAL_SECTION( {
+        prio = DISPATCH_PRIORITIES - __builtin_ff1r(__pending);
+        idx  = __head[prio];
+        slot = &__slots[idx];
+        __head[prio] = slot->next;
+        if( __head[prio] == DISPATCH_NONE ) {
+            __tail[prio] = DISPATCH_NONE;
+            __pending   &= ~(1u << DISPATCH_BIT(prio));
+        }
+        callback = slot->callback;
+        stat     = slot->stat;
+        memcpy(event, slot->event, sizeof(event));
+        slot->next = __free;
+        __free     = idx;
+    } );
+
+    __dispatch_call(stat, callback, event);
+}
@@ -0,0 +1,455 @@
+/************************************************************
+ * File:    BSP_LedBlink.c                                  *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_LedBlink.h>
+#include <BSP_LedDim.h>
+#include <BSP_Dispatch.h>
+
+/*******************************************************
+ * LED objects
+ *******************************************************/
+static led_t __leds[LED_MAX_COUNT];
+
+/*******************************************************
+ * Edge scheduler
+ * - __now:    Free-running tick counter of the executor.
+ * - __next:   Tick of the earliest edge of the active LEDs.
+ * - __active: Bit mask of the LEDs that are not idle.
+ *******************************************************/
+static uint32_t          __now;
+static uint32_t          __next;
+static volatile uint16_t __active;
+
+/*******************************************************
+ * Returns true if the tick (a) is at or after the tick (b)
+ *******************************************************/
+#define LED_TICK_REACHED(a, b)  ((int32_t)((a) - (b)) >= 0)
+
+
+/************************************************************
+ * __led_schedule
+ * Sets the next edge of the LED to the given tick.
+ * The edge is never placed before the next tick.
+ ************************************************************/
+static void __led_schedule(led_t *led, uint32_t deadline) {
+    if( LED_TICK_REACHED(__now, deadline) ) {
+        deadline = __now + 1;
+    }
+    led->deadline = deadline;
+}
+
+
+/************************************************************
+ * __led_activate
+ * Adds the LED to the active mask and updates the earliest edge.
+ * It must be called in the critical section.
+ ************************************************************/
+static void __led_activate(led_t *led) {
+    if( __active == 0 || !LED_TICK_REACHED(led->deadline, __next) ) {
+        __next = led->deadline;
+    }
+    __active |= (1u << led->id);
+}
+
+
+/************************************************************
+ * __led_start
+ * Starts the operation of the LED from the BEGIN state.
+ ************************************************************/
+static void __led_start(led_t *led, uint16_t mode) {
+    if( led->dimmed && mode != LED_MODE_PAT ) {
+        led->dimmed = false;
+        Led_DimRelease(led->id);
+    }
+    PERFORM_CRITICAL_SECTION( {
+        led->mode   = mode;
+        led->state  = LED_STATE_BEGIN;
+        led->origin = __now;
+        __led_schedule(led, led->origin + led->shift);
+        __led_activate(led);
+    } );
+}
+
+
+/************************************************************
+ * Led_BlinkInit
+ ************************************************************/
+void Led_BlinkInit(void) {
+    int16_t i;
+    led_t *ptr = __leds;
+    for( i = 0; i < LED_MAX_COUNT; i++ ) {
+        ptr->id       = i;
+        ptr->mode     = LED_MODE_FLS;
+        ptr->origin   = 0;
+        ptr->deadline = 0;
+        ptr->period   = 500;
+        ptr->width    = 50;
+        ptr->shift    = 0;
+        ptr->counter  = 0;
+        ptr->state    = LED_STATE_IDLE;
+        ptr->script   = NULL;
+        ptr->dimmed   = false;
+        ptr++;
+    }
+    __now    = 0;
+    __next   = 0;
+    __active = 0;
+}
+
+
+/************************************************************
+ * Led_Flash
+ ************************************************************/
+void Led_Flash(int16_t id, uint16_t width) {
+    led_t *led = &__leds[id];
+    led->width = width;
+    led->shift = 0;
+    __led_start(led, LED_MODE_FLS);
+}
+
+
+/************************************************************
+ * Led_Blink
+ ************************************************************/
+void Led_Blink(int16_t id, uint16_t shift, uint16_t width) {
+    led_t *led = &__leds[id];
+    led->shift = shift;
+    led->width = width;
+    __led_start(led, LED_MODE_BLK);
+}
+
+
+/************************************************************
+ * Led_Pwm
+ ************************************************************/
+void Led_Pwm(int16_t id, uint16_t shift, uint16_t width, uint16_t period) {
+    led_t *led  = &__leds[id];
+    led->shift  = shift;
+    led->width  = width;
+    led->period = period;
+    __led_start(led, LED_MODE_PWM);
+    Led_Clr(id);
+}
+
+
+/************************************************************
+ * Led_Pattern
+ ************************************************************/
+void Led_Pattern(int16_t id, const uint8_t *script) {
+    led_t *led  = &__leds[id];
+    led->script = script;
+    led->pc     = 0;
+    led->depth  = 0;
+    led->shift  = 0;
+    __led_start(led, LED_MODE_PAT);
+}
+
+
+/************************************************************
+ * Led_PatternStop
+ ************************************************************/
+void Led_PatternStop(int16_t id) {
+    led_t *led = &__leds[id];
+    Led_SetMode(id, LED_MODE_LED);
+    if( led->dimmed ) {
+        led->dimmed = false;
+        Led_DimRelease(id);
+    }
+    Led_Clr(id);
+}
+
+
+/************************************************************
+ * Led_SetChangedCallback
+ ************************************************************/
+void Led_SetChangedCallback(int16_t id, callback_t callback) {
+    __leds[id].callback = callback;
+}
+
+
+/************************************************************
+ * Led_SetMode
+ ************************************************************/
+void Led_SetMode(int16_t id, int16_t mode) {
+    PERFORM_CRITICAL_SECTION( {
+        __leds[id].mode = mode;
+        if( mode == LED_MODE_LED ) {
+            __leds[id].state = LED_STATE_IDLE;
+            __active &= ~(1u << id);
+        }
+    } );
+}
+
+
+/************************************************************
+ * Led_BlinkGetIdleTicks
+ ************************************************************/
+uint16_t Led_BlinkGetIdleTicks(void) {
+    uint32_t ticks;
+    if( __active == 0 ) {
+        return 0xFFFF;
+    }
+    ticks = __next - __now;
+    return (ticks < 0xFFFF) ? (uint16_t)ticks : 0xFFFF;
+}
+
+
+/************************************************************
+ * __led_output
+ * Writes the pattern output. The dimmer is only used by the
+ * LED_OP_DIM, the other operations release it.
+ ************************************************************/
+static void __led_output(led_t *led, uint8_t op, uint8_t level) {
+    if( op == LED_OP_DIM ) {
+        led->dimmed = true;
+        Led_DimSet(led->id, level);
+        return;
+    }
+    if( led->dimmed ) {
+        led->dimmed = false;
+        Led_DimRelease(led->id);
+    }
+    if( op == LED_OP_ON ) {
+        Led_Set(led->id);
+    }
+    else {
+        Led_Clr(led->id);
+    }
+}
+
+
+/************************************************************
+ * __led_skip
+ * Moves the pc behind the LOOP of the REPEAT block that
+ * starts at the pc (the count 0 block). The pc is left at
+ * the END if the block has no LOOP.
+ ************************************************************/
+static void __led_skip(led_t *led) {
+
+    const uint8_t *code  = led->script;
+    uint8_t        nest  = 0, op;
+    uint16_t       bytes;
+
+    for( bytes = 0; bytes < 0xFF; bytes++ ) {
+        op = code[led->pc];
+        switch( op ) {
+            case LED_OP_DIM:    led->pc += 3; break;
+            case LED_OP_ON:
+            case LED_OP_OFF:
+            case LED_OP_WAIT:
+            case LED_OP_JUMP:   led->pc += 2; break;
+            case LED_OP_REPEAT: led->pc += 2; nest++; break;
+            case LED_OP_LOOP:
+                led->pc++;
+                if( nest-- == 0 ) {
+                    return;
+                }
+                break;
+            default:            // LED_OP_END and unknown operations.
+                return;
+        }
+    }
+}
+
+
+/************************************************************
+ * __led_pattern
+ * Interprets the pattern script up to the next timed operation.
+ * Returns false if the pattern is completed.
+ ************************************************************/
+static bool __led_pattern(led_t *led) {
+
+    const uint8_t *code = led->script;
+    uint8_t        op, level = 0, units;
+    uint16_t       steps;
+
+    led->state = LED_STATE_RUN;
+
+    for( steps = 0; steps < LED_PATTERN_MAX_STEPS; steps++ ) {
+
+        op = code[led->pc++];
+        switch( op ) {
+
+            case LED_OP_DIM:
+                level = code[led->pc++];
+                // no break, the time follows.
+            case LED_OP_ON:
+            case LED_OP_OFF:
+                __led_output(led, op, level);
+                // no break, the time follows.
+            case LED_OP_WAIT:
+                units = code[led->pc++];
+                if( units > 0 ) {
+                    __led_schedule(led, __now + (uint16_t)units * LED_PATTERN_UNIT_MS);
+                    return true;
+                }
+                break;
+
+            case LED_OP_REPEAT:
+                if( code[led->pc] == 0 ) {
+                    led->pc++;
+                    __led_skip(led);    // Count 0, the block is skipped.
+                }
+                else if( led->depth < LED_PATTERN_DEPTH ) {
+                    led->loop_count[led->depth] = code[led->pc++];
+                    led->loop_pc[led->depth]    = led->pc;
+                    led->depth++;
+                }
+                else {
+                    led->pc++;  // Too deep, the block runs once.
+                }
+                break;
+
+            case LED_OP_LOOP:
+                if( led->depth > 0 ) {
+                    if( led->loop_count[led->depth-1] > 1 ) {
+                        led->loop_count[led->depth-1]--;
+                        led->pc = led->loop_pc[led->depth-1];
+                    }
+                    else {
+                        led->depth--;
+                    }
+                }
+                break;
+
+            case LED_OP_JUMP:
+                // Only a backward jump is taken, it stays inside the script.
+                if( code[led->pc] >= led->pc ) {
+                    steps = LED_PATTERN_MAX_STEPS;
+                    break;
+                }
+                led->pc = code[led->pc];
+                // The blocks that start behind the target are left.
+                while( led->depth > 0 && led->loop_pc[led->depth-1] > led->pc ) {
+                    led->depth--;
+                }
+                break;
+
+            default:    // LED_OP_END and unknown operations.
+                steps = LED_PATTERN_MAX_STEPS;
+                break;
+        }
+    }
+
+    // Completed, or no timed operation within the step limit.
+    // A dimmed LED is released (turned off).
+    if( led->dimmed ) {
+        led->dimmed = false;
+        Led_DimRelease(led->id);
+    }
+    led->state = LED_STATE_IDLE;
+    led->mode  = LED_MODE_LED;
+    return false;
+}
+
+
+/************************************************************
+ * __led_edge
+ * Performs the transition of the LED and computes its next edge.
+ * Returns false if the LED becomes idle.
+ ************************************************************/
+static bool __led_edge(led_t *led) {
+
+    if( led->mode == LED_MODE_PAT ) {
+        return __led_pattern(led);
+    }
+
+    switch( led->state ) {
+
+        case LED_STATE_BEGIN:
+            led->state = LED_STATE_ON;
+            Led_Set(led->id);
+            // The width starts at the tick of this edge, a shift 0 edge is one tick after the origin.
+            __led_schedule(led, led->deadline + led->width);
+            return true;
+
+        case LED_STATE_ON:
+            Led_Clr(led->id);
+            if( led->mode == LED_MODE_FLS || led->mode == LED_MODE_BLK ) {
+                led->state = LED_STATE_IDLE;
+                led->mode  = LED_MODE_LED;
+                return false;
+            }
+            led->state = LED_STATE_OFF;
+            __led_schedule(led, led->origin + led->period);
+            return true;
+
+        case LED_STATE_OFF:
+            led->state  = LED_STATE_BEGIN;
+            led->origin = __now;
+            __led_schedule(led, led->origin + led->shift);
+            return true;
+    }
+    return false;
+}
+
+
+/************************************************************
+ * LED_BlinkTickedExecutor
+ ************************************************************/
+inline void LED_BlinkTickedExecutor(void) {
+
+    led_t       *led;
+    led_event_t  evt;
+    uint16_t     mask, bit, id;
+    uint32_t     next;
+
+    /*********************************
+     * Nothing is due at this tick
+     *********************************/
+    __now++;
+    if( __active == 0 || !LED_TICK_REACHED(__now, __next) ) {
+        return;
+    }
+
+    /*********************************
+     * Due edges of the active LEDs
+     *********************************/
+    mask = __active;
+    while( mask != 0 ) {
+        id    = __builtin_ff1r(mask) - 1;
+        bit   = 1u << id;
+        mask &= ~bit;
+        led   = &__leds[id];
+
+        if( !LED_TICK_REACHED(__now, led->deadline) ) {
+            continue;
+        }
+
+        if( !__led_edge(led) ) {
+            PERFORM_CRITICAL_SECTION( __active &= ~bit );
+        }
+
+        // The pattern only reports its completion.
+        if( led->callback != NULL && led->state != LED_STATE_RUN ) {
+            led->counter++;
+            evt.id      = id;
+            evt.mode    = led->mode;
+            evt.state   = led->state;
+            evt.counter = led->counter;
+            evt.sender  = led;
+            Dispatch_Post(led->callback, &evt, sizeof(evt));
+        }
+    }
+
+    /*********************************
+     * Earliest edge of the active LEDs
+     *********************************/
+    PERFORM_CRITICAL_SECTION( {
+        mask = __active;
+        next = __now + 0x7FFFFFFF;
+        while( mask != 0 ) {
+            id    = __builtin_ff1r(mask) - 1;
+            mask &= ~(1u << id);
+            if( !LED_TICK_REACHED(__leds[id].deadline, next) ) {
+                next = __leds[id].deadline;
+            }
+        }
+        __next = next;
+    } );
+}
@@ -0,0 +1,350 @@
+/************************************************************
+ * File:    BSP_LedDim.c                                    *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_LedDim.h>
+
+/*******************************************************
+ * Number of BAM slots (bits of the duty cycle)
+ *******************************************************/
+#define LED_DIM_SLOTS       8
+
+/*******************************************************
+ * LAT bits of the LEDs (see the BSP_Led.h)
+ *******************************************************/
+static const uint16_t __lat_a_bits[LED_MAX_COUNT] = { 1u<<2, 1u<<4, 0,     0     };
+static const uint16_t __lat_b_bits[LED_MAX_COUNT] = { 0,     0,     1u<<2, 1u<<3 };
+
+/*******************************************************
+ * Timer4 period of each slot (weighted by the bit)
+ *******************************************************/
+static const uint16_t __slot_periods[LED_DIM_SLOTS] = {
+    (LED_DIM_SLOT_CYCLES <<  0) - 1, (LED_DIM_SLOT_CYCLES <<  1) - 1,
+    (LED_DIM_SLOT_CYCLES <<  2) - 1, (LED_DIM_SLOT_CYCLES <<  3) - 1,
+    (LED_DIM_SLOT_CYCLES <<  4) - 1, (LED_DIM_SLOT_CYCLES <<  5) - 1,
+    (LED_DIM_SLOT_CYCLES <<  6) - 1, (LED_DIM_SLOT_CYCLES <<  7) - 1,
+};
+
+/*******************************************************
+ * Gamma correction table (gamma = 2.2)
+ *******************************************************/
+static const uint8_t __gamma_table[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+/*******************************************************
+ * DIMMED LED STRUCTURE
+ *******************************************************/
+typedef struct {
+    uint16_t    level;          // Brightness level (8.8 fixed-point).
+    int16_t     step;           // Fading step per tick (8.8 fixed-point).
+    uint16_t    ticks;          // Remaining ticks of the fading.
+    uint8_t     target;         // Final level of the fading.
+    uint8_t     duty;           // Duty cycle written to the frame.
+}dim_led_t;
+
+/*******************************************************
+ * BAM FRAME STRUCTURE (port images of the slots)
+ * A bit is set when the LED is off (active low).
+ *******************************************************/
+typedef struct {
+    uint16_t    lata[LED_DIM_SLOTS];
+    uint16_t    latb[LED_DIM_SLOTS];
+}dim_frame_t;
+
+/*******************************************************
+ * Dimmer objects
+ * - __frames:  Front (ISR) and back (executor) frames.
+ * - __front:   Index of the front frame.
+ * - __pending: The back frame is ready, it becomes the
+ *              front frame at the beginning of the next frame.
+ * - __mask_a/b: LAT bits owned by the dimmer.
+ * - __dimmed:  Bit mask of the dimmed LEDs.
+ * - __fading:  Bit mask of the fading LEDs.
+ *******************************************************/
+static dim_led_t            __leds[LED_MAX_COUNT];
+static dim_frame_t          __frames[2];
+static volatile uint16_t    __front;
+static volatile bool        __pending;
+static volatile uint16_t    __mask_a;
+static volatile uint16_t    __mask_b;
+static uint16_t             __slot;
+static uint16_t             __dimmed;
+static uint16_t             __fading;
+
+
+/************************************************************
+ * Led_DimInit
+ ************************************************************/
+void Led_DimInit(void) {
+
+    T4CONbits.TON   = 0;        // Stopped
+    T4CONbits.T32   = 0;        // 16-bit timer
+    T4CONbits.TCKPS = 0;        // Prescaler 1:1
+    T4CONbits.TCS   = 0;        // Internal clock (FCY)
+    T4CONbits.TGATE = 0;        // Gated time accumulation disabled
+    TMR4            = 0;
+    PR4             = __slot_periods[0];
+    IPC6bits.T4IP   = LED_DIM_ISR_PRIORITY;
+    IFS1bits.T4IF   = 0;
+    IEC1bits.T4IE   = 0;
+
+    memset(__leds,   0, sizeof(__leds));
+    memset(__frames, 0, sizeof(__frames));
+    __front   = 0;
+    __pending = false;
+    __mask_a  = 0;
+    __mask_b  = 0;
+    __slot    = 0;
+    __dimmed  = 0;
+    __fading  = 0;
+}
+
+
+/************************************************************
+ * __dim_build
+ * Builds the port images of the back frame from the duty
+ * cycles of the dimmed LEDs and passes it to the ISR.
+ ************************************************************/
+static void __dim_build(void) {
+
+    dim_frame_t *frame;
+    uint16_t     back, slot, id, bit, lata, latb;
+
+    // The ISR must not take the back frame while it is being built.
+    PERFORM_CRITICAL_SECTION( {
+        __pending = false;
+        back      = __front ^ 1;
+    } );
+
+    frame = &__frames[back];
+    for( slot = 0, bit = 1; slot < LED_DIM_SLOTS; slot++, bit <<= 1 ) {
+        lata = 0xFFFF;
+        latb = 0xFFFF;
+        for( id = 0; id < LED_MAX_COUNT; id++ ) {
+            if( __leds[id].duty & bit ) {
+                lata &= ~__lat_a_bits[id];
+                latb &= ~__lat_b_bits[id];
+            }
+        }
+        frame->lata[slot] = lata;
+        frame->latb[slot] = latb;
+    }
+
+    __pending = true;
+}
+
+
+/************************************************************
+ * __dim_attach
+ * Passes the LED to the dimmer and starts the Timer4.
+ ************************************************************/
+static void __dim_attach(int16_t id) {
+
+    if( __dimmed & (1u << id) ) {
+        return;
+    }
+
+    PERFORM_CRITICAL_SECTION( {
+        __mask_a |= __lat_a_bits[id];
+        __mask_b |= __lat_b_bits[id];
+    } );
+
+    if( __dimmed == 0 ) {
+        __slot        = 0;
+        TMR4          = 0;
+        PR4           = __slot_periods[0];
+        IFS1bits.T4IF = 0;
+        IEC1bits.T4IE = 1;
+        T4CONbits.TON = 1;
+    }
+    __dimmed |= (1u << id);
+}
+
+
+/************************************************************
+ * __dim_write
+ * Writes the level and the duty cycle of the LED.
+ ************************************************************/
+static void __dim_write(int16_t id, uint8_t level, uint8_t duty) {
+    dim_led_t *led = &__leds[id];
+    led->level  = (uint16_t)level << 8;
+    led->target = level;
+    led->ticks  = 0;
+    led->duty   = duty;
+    __fading   &= ~(1u << id);
+    __dim_attach(id);
+    __dim_build();
+}
+
+
+/************************************************************
+ * Led_DimSet
+ ************************************************************/
+void Led_DimSet(int16_t id, uint8_t level) {
+    __dim_write(id, level, __gamma_table[level]);
+}
+
+
+/************************************************************
+ * Led_DimSetDuty
+ ************************************************************/
+void Led_DimSetDuty(int16_t id, uint8_t duty) {
+    __dim_write(id, duty, duty);
+}
+
+
+/************************************************************
+ * Led_DimFade
+ ************************************************************/
+void Led_DimFade(int16_t id, uint8_t level, uint16_t interval) {
+
+    dim_led_t *led = &__leds[id];
+    int16_t    diff;
+
+    // The step of one tick does not fit the 8.8 fixed-point.
+    if( interval < 2 ) {
+        Led_DimSet(id, level);
+        return;
+    }
+
+    diff        = (int16_t)level - (int16_t)(led->level >> 8);
+    led->level &= 0xFF00;
+    led->target = level;
+    led->ticks  = interval;
+    led->step   = __builtin_divsd((int32_t)diff << 8, interval);
+    __fading   |= (1u << id);
+    __dim_attach(id);
+}
+
+
+/************************************************************
+ * Led_DimGet
+ ************************************************************/
+uint8_t Led_DimGet(int16_t id) {
+    return (uint8_t)(__leds[id].level >> 8);
+}
+
+
+/************************************************************
+ * Led_DimRelease
+ ************************************************************/
+void Led_DimRelease(int16_t id) {
+
+    if( !(__dimmed & (1u << id)) ) {
+        return;
+    }
+
+    __dimmed &= ~(1u << id);
+    __fading &= ~(1u << id);
+    __leds[id].duty  = 0;
+    __leds[id].level = 0;
+
+    // The ISR stops writing the LED immediately.
+    PERFORM_CRITICAL_SECTION( {
+        __mask_a &= ~__lat_a_bits[id];
+        __mask_b &= ~__lat_b_bits[id];
+    } );
+
+    if( __dimmed == 0 ) {
+        T4CONbits.TON = 0;
+        IEC1bits.T4IE = 0;
+    }
+    __dim_build();
+    Led_Clr(id);
+}
+
+
+/************************************************************
+ * Led_DimIsIdle
+ ************************************************************/
+bool Led_DimIsIdle(void) {
+    return __fading == 0;
+}
+
+
+/************************************************************
+ * LED_DimTickedExecutor
+ ************************************************************/
+inline void LED_DimTickedExecutor(void) {
+
+    dim_led_t *led;
+    uint16_t   mask, bit, id;
+    uint8_t    duty;
+    bool       changed = false;
+
+    if( __fading == 0 ) {
+        return;
+    }
+
+    mask = __fading;
+    while( mask != 0 ) {
+        id    = __builtin_ff1r(mask) - 1;
+        bit   = 1u << id;
+        mask &= ~bit;
+        led   = &__leds[id];
+
+        if( --led->ticks == 0 ) {
+            led->level = (uint16_t)led->target << 8;
+            __fading  &= ~bit;
+        }
+        else {
+            led->level += led->step;
+        }
+
+        duty = __gamma_table[led->level >> 8];
+        if( duty != led->duty ) {
+            led->duty = duty;
+            changed   = true;
+        }
+    }
+
+    if( changed ) {
+        __dim_build();
+    }
+}
+
+
+/************************************************************
+ * Timer4 Interrupt Service Routine (BAM slots)
+ * The port images of the slot are written and the Timer4
+ * period is set to the weight of the slot.
+ ************************************************************/
+void __attribute__((interrupt, auto_psv)) _T4Interrupt(void) {
+
+    const dim_frame_t *frame;
+    uint16_t           slot = __slot;
+
+    // A new frame begins, take the back frame if it is ready.
+    if( slot == 0 && __pending ) {
+        __front  ^= 1;
+        __pending = false;
+    }
+
+    frame = &__frames[__front];
+    LATA  = (LATA & ~__mask_a) | (frame->lata[slot] & __mask_a);
+    LATB  = (LATB & ~__mask_b) | (frame->latb[slot] & __mask_b);
+    PR4   = __slot_periods[slot];
+
+    __slot = (slot + 1) & (LED_DIM_SLOTS - 1);
+    IFS1bits.T4IF = 0;
+}
@@ -0,0 +1,178 @@
+/************************************************************
+ * File:    BSP_Load.c                                      *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_Load.h>
+
+/*******************************************************
+ * Idle accounting (timer counts)
+ * - __idle:       The idle interval is open.
+ * - __idle_begin: Clock at the beginning of the interval.
+ * - __idle_sum:   Idle counts of the current window.
+ *******************************************************/
+static volatile bool        __idle;
+static volatile uint32_t    __idle_begin;
+static volatile uint32_t    __idle_sum;
+
+/*******************************************************
+ * Windows
+ * - __window_begin: Clock at the beginning of the window.
+ * - __ticks:        Ticks of the current window.
+ * - __busy/__total: Busy and total counts of the last
+ *                   LOAD_WINDOW_COUNT windows (ring).
+ *******************************************************/
+static uint32_t     __window_begin;
+static uint16_t     __ticks;
+static uint32_t     __busy[LOAD_WINDOW_COUNT];
+static uint32_t     __total[LOAD_WINDOW_COUNT];
+static uint16_t     __index;
+
+/*******************************************************
+ * Loads (permille)
+ *******************************************************/
+static uint16_t     __load_1s;
+static uint16_t     __load_10s;
+static uint16_t     __load_peak;
+
+
+/************************************************************
+ * Load_Init
+ ************************************************************/
+void Load_Init(void) {
+    memset(__busy,  0, sizeof(__busy));
+    memset(__total, 0, sizeof(__total));
+    __index     = 0;
+    __ticks     = 0;
+    __load_1s   = 0;
+    __load_10s  = 0;
+    __load_peak = 0;
+    PERFORM_CRITICAL_SECTION( {
+        __idle         = false;
+        __idle_sum     = 0;
+        __window_begin = Clock_GetCounts();
+    } );
+}
+
+
+/************************************************************
+ * Load_IdleEnter
+ ************************************************************/
+void Load_IdleEnter(void) {
+    if( __idle ) {
+        return;
+    }
+    PERFORM_CRITICAL_SECTION( {
+        __idle_begin = Clock_GetCounts();
+        __idle       = true;
+    } );
+}
+
+
+/************************************************************
+ * Load_IdleExit
+ ************************************************************/
+void Load_IdleExit(void) {
+    if( !__idle ) {
+        return;
+    }
+    PERFORM_CRITICAL_SECTION( {
+        __idle_sum += Clock_GetCounts() - __idle_begin;
+        __idle      = false;
+    } );
+}
+
+
+/************************************************************
+ * __load_permille
+ * Returns the busy part of the total counts (permille).
+ ************************************************************/
+static uint16_t __load_permille(uint32_t busy, uint32_t total) {
+    total /= 1000;
+    if( total == 0 ) {
+        return 0;
+    }
+    busy /= total;
+    return (busy < 1000) ? (uint16_t)busy : 1000;
+}
+
+
+/************************************************************
+ * Load_Get1s
+ ************************************************************/
+uint16_t Load_Get1s(void) {
+    return __load_1s;
+}
+
+
+/************************************************************
+ * Load_Get10s
+ ************************************************************/
+uint16_t Load_Get10s(void) {
+    return __load_10s;
+}
+
+
+/************************************************************
+ * Load_GetPeak
+ ************************************************************/
+uint16_t Load_GetPeak(void) {
+    return __load_peak;
+}
+
+
+/************************************************************
+ * Load_ResetPeak
+ ************************************************************/
+void Load_ResetPeak(void) {
+    __load_peak = 0;
+}
+
+
+/************************************************************
+ * LOAD_TickedExecutor
+ ************************************************************/
+inline void LOAD_TickedExecutor(void) {
+
+    uint32_t now, total, idle, busy, busy_sum, total_sum;
+    uint16_t i;
+
+    if( ++__ticks < LOAD_WINDOW_TICKS ) {
+        return;
+    }
+    __ticks = 0;
+
+    // Closes the window, an open idle interval is split.
+    PERFORM_CRITICAL_SECTION( {
+        now = Clock_GetCounts();
+        if( __idle ) {
+            __idle_sum  += now - __idle_begin;
+            __idle_begin = now;
+        }
+        idle           = __idle_sum;
+        __idle_sum     = 0;
+        total          = now - __window_begin;
+        __window_begin = now;
+    } );
+
+    busy             = (idle < total) ? (total - idle) : 0;
+    __total[__index] = total;
+    __busy[__index]  = busy;
+    __index          = (__index + 1) % LOAD_WINDOW_COUNT;
+
+    __load_1s = __load_permille(busy, total);
+    if( __load_1s > __load_peak ) {
+        __load_peak = __load_1s;
+    }
+
+    busy_sum  = 0;
+    total_sum = 0;
+    for( i = 0; i < LOAD_WINDOW_COUNT; i++ ) {
+        busy_sum  += __busy[i];
+        total_sum += __total[i];
+    }
+    __load_10s = __load_permille(busy_sum, total_sum);
+}
@@ -0,0 +1,176 @@
+/************************************************************
+ * File:    BSP_Main.c                                      *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_Main.h>
+
+/*******************************************************
+ * Number of system ticks not executed yet
+ *******************************************************/
+static volatile uint16_t bsp_isr_ticks;
+
+/*******************************************************
+ * Bit mask of the pending works (BSP_WORK_x)
+ *******************************************************/
+static volatile uint16_t bsp_pending;
+
+
+/************************************************************
+ * BSP_TickIsrExecutor
+ ************************************************************/
+inline void BSP_TickIsrExecutor(void) {
+    bsp_isr_ticks++;
+    bsp_pending |= (1u << BSP_WORK_TICK);
+}
+
+
+/************************************************************
+ * BSP_TickIsrAddTicks
+ ************************************************************/
+void BSP_TickIsrAddTicks(uint16_t ticks) {
+    if( ticks == 0 ) {
+        return;
+    }
+    PERFORM_CRITICAL_SECTION( {
+        bsp_isr_ticks += ticks;
+        bsp_pending   |= (1u << BSP_WORK_TICK);
+    } );
+}
+
+
+/************************************************************
+ * BSP_GetPending
+ ************************************************************/
+uint16_t BSP_GetPending(void) {
+    uint16_t pending = bsp_pending;
+    if( Dispatch_IsPending() ) {
+        pending |= (1u << BSP_WORK_DISPATCH);
+    }
+    return pending;
+}
+
+
+/************************************************************
+ * BSP_GetIdleTicks
+ ************************************************************/
+uint16_t BSP_GetIdleTicks(void) {
+
+    uint16_t ticks = BSP_IDLE_MAX_TICKS, t;
+
+    if( BSP_GetPending() != 0 || !Psw_IsIdle() || !Led_DimIsIdle() ) {
+        return 0;
+    }
+
+    t = Led_BlinkGetIdleTicks();
+    if( t < ticks ) {
+        ticks = t;
+    }
+    t = Beep_GetIdleTicks();
+    if( t < ticks ) {
+        ticks = t;
+    }
+    return ticks;
+}
+
+
+/************************************************************
+ * __bsp_tick_work
+ * Executes one tick of the ticked executors. The bit is
+ * cleared when the last pending tick is taken.
+ ************************************************************/
+static void __bsp_tick_work(void) {
+
+    PERFORM_CRITICAL_SECTION( {
+        if( --bsp_isr_ticks == 0 ) {
+            bsp_pending &= ~(1u << BSP_WORK_TICK);
+        }
+    } );
+
+    PROFILE_BEGIN(PROFILE_SITE_PSW_TICKED);
+    PSW_KeyTickedExecutor();
+    PROFILE_END(PROFILE_SITE_PSW_TICKED);
+
+    PROFILE_BEGIN(PROFILE_SITE_LED_BLINK_TICKED);
+    LED_BlinkTickedExecutor();
+    PROFILE_END(PROFILE_SITE_LED_BLINK_TICKED);
+
+    PROFILE_BEGIN(PROFILE_SITE_LED_DIM_TICKED);
+    LED_DimTickedExecutor();
+    PROFILE_END(PROFILE_SITE_LED_DIM_TICKED);
+
+    PROFILE_BEGIN(PROFILE_SITE_BEEP_TICKED);
+    BEEP_TickedExecutor();
+    PROFILE_END(PROFILE_SITE_BEEP_TICKED);
+
+    PROFILE_BEGIN(PROFILE_SITE_ADC_TICKED);
+    ADC_TickedExecutor();
+    PROFILE_END(PROFILE_SITE_ADC_TICKED);
+
+    LOAD_TickedExecutor();
+}
+
+
+/************************************************************
+ * __bsp_dispatch_work
+ * Performs one posted callback.
+ ************************************************************/
+static void __bsp_dispatch_work(void) {
+    PROFILE_BEGIN(PROFILE_SITE_DISPATCH);
+    Dispatch_Executor();
+    PROFILE_END(PROFILE_SITE_DISPATCH);
+}
+
+
+/*******************************************************
+ * Works of the pending bits
+ *******************************************************/
+static void (* const __works[BSP_WORK_COUNT])(void) = {
+    __bsp_tick_work,        // BSP_WORK_TICK
+    __bsp_dispatch_work,    // BSP_WORK_DISPATCH
+};
+
+
+/************************************************************
+ * BSP_Executor
+ ************************************************************/
+inline void BSP_Executor(void) {
+
+    uint16_t pending, work;
+
+    // The UART receive ISRs are in the BSP library, they cannot set
+    // a pending bit. The executors are polled on every call.
+    PROFILE_BEGIN(PROFILE_SITE_UART_EXECUTOR);
+    Uart1_Executor();
+    Uart2_Executor();
+    PROFILE_END(PROFILE_SITE_UART_EXECUTOR);
+
+    pending = BSP_GetPending();
+    while( pending != 0 ) {
+        work     = __builtin_ff1r(pending) - 1;
+        pending &= ~(1u << work);
+        __works[work]();
+    }
+}
+
+
+/************************************************************
+ * BSP_Idle
+ ************************************************************/
+void BSP_Idle(bool (*is_pending)(void)) {
+    #if BSP_IDLE_ENABLE > 0
+        int  old_ipl;
+        bool pending;
+        SET_AND_SAVE_CPU_IPL(old_ipl, 7);
+        pending = (is_pending != NULL) ? is_pending() : (BSP_GetPending() != 0);
+        if( !pending ) {
+            Idle();     // Woken by any enabled interrupt, it is serviced after the IPL is restored.
+        }
+        RESTORE_CPU_IPL(old_ipl);
+    #else
+        (void)is_pending;
+    #endif
+}
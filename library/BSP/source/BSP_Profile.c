@@ -0,0 +1,128 @@
+/************************************************************
+ * File:    BSP_Profile.c                                   *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_Profile.h>
+#include <BSP_Uart.h>
+
+#if BSP_PROFILE_ENABLE > 0
+
+/*******************************************************
+ * Profiler objects
+ * - profile_begins: Timer counts at PROFILE_BEGIN.
+ * - __stats:        Statistics of the sites.
+ * - __overhead:     Counts of an empty BEGIN/END pair.
+ *******************************************************/
+volatile uint16_t       profile_begins[PROFILE_MAX_SITES];
+static profile_stat_t   __stats[PROFILE_MAX_SITES];
+static uint16_t         __overhead;
+
+/*******************************************************
+ * Names of the sites (the user sites are numbered)
+ *******************************************************/
+static const char *__names[PROFILE_SITE_USER] = {
+    "TICK_ISR", "BSP_TICK_ISR", "RTL_TICK_ISR", "UART_EXEC", "PSW_TICKED",
+    "LED_BLINK", "LED_DIM", "BEEP_TICKED", "ADC_TICKED", "DISPATCH",
+};
+
+
+/************************************************************
+ * Profile_Reset
+ ************************************************************/
+void Profile_Reset(void) {
+    uint16_t i;
+    PERFORM_CRITICAL_SECTION( {
+        memset(__stats, 0, sizeof(__stats));
+        for( i = 0; i < PROFILE_MAX_SITES; i++ ) {
+            __stats[i].min = 0xFFFF;
+        }
+    } );
+}
+
+
+/************************************************************
+ * Profile_Init
+ ************************************************************/
+void Profile_Init(void) {
+    __overhead = 0;
+    PERFORM_CRITICAL_SECTION( {
+        PROFILE_BEGIN(PROFILE_SITE_USER);
+        __overhead = CLOCK_STAMP_COUNTS() - profile_begins[PROFILE_SITE_USER];
+    } );
+    Profile_Reset();
+}
+
+
+/************************************************************
+ * Profile_Record
+ ************************************************************/
+void Profile_Record(uint16_t site, uint16_t counts) {
+
+    profile_stat_t *stat;
+
+    if( site >= PROFILE_MAX_SITES ) {
+        return;
+    }
+    stat   = &__stats[site];
+    counts = (counts > __overhead) ? (counts - __overhead) : 0;
+
+    PERFORM_CRITICAL_SECTION( {
+        stat->count++;
+        if( counts < stat->min ) {
+            stat->min = counts;
+        }
+        if( counts > stat->max ) {
+            stat->max = counts;
+        }
+        // The sum is halved before it overflows, the average is kept.
+        if( stat->sum >= 0xFFFF0000UL || stat->samples == 0xFFFF ) {
+            stat->sum     >>= 1;
+            stat->samples >>= 1;
+        }
+        stat->sum += counts;
+        stat->samples++;
+    } );
+}
+
+
+/************************************************************
+ * Profile_Get
+ ************************************************************/
+bool Profile_Get(uint16_t site, profile_stat_t *stat) {
+    if( site >= PROFILE_MAX_SITES ) {
+        return false;
+    }
+    PERFORM_CRITICAL_SECTION( *stat = __stats[site] );
+    return true;
+}
+
+
+/************************************************************
+ * Profile_Dump
+ ************************************************************/
+void Profile_Dump(void) {
+
+    profile_stat_t stat;
+    uint16_t       site, avg;
+
+    Uart1_Printf("\r\nSITE          COUNT       MIN    MAX    AVG (counts)\r\n");
+    for( site = 0; site < PROFILE_MAX_SITES; site++ ) {
+        Profile_Get(site, &stat);
+        if( stat.count == 0 ) {
+            continue;
+        }
+        avg = __builtin_divud(stat.sum, stat.samples);
+        if( site < PROFILE_SITE_USER ) {
+            Uart1_Printf("%-12s  %10lu  %5u  %5u  %5u\r\n", __names[site], stat.count, stat.min, stat.max, avg);
+        }
+        else {
+            Uart1_Printf("USER_%-7u  %10lu  %5u  %5u  %5u\r\n", site - PROFILE_SITE_USER, stat.count, stat.min, stat.max, avg);
+        }
+    }
+}
+
+#endif // BSP_PROFILE_ENABLE
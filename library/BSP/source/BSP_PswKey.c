@@ -0,0 +1,539 @@
+/************************************************************
+ * File:    BSP_PswKey.c                                    *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <BSP_PswKey.h>
+#include <BSP_Dispatch.h>
+
+/*******************************************************
+ * Switch objects
+ *******************************************************/
+static switch_t switches[PSW_MAX_KEYS];
+
+/*******************************************************
+ * Default key timing and chord callback
+ *******************************************************/
+static const psw_timing_t __default_timing = PSW_TIMING_DEFAULT;
+static callback_t         __chord_callback;
+
+/*******************************************************
+ * Switch event hook and the events not posted to the
+ * dispatcher (its queue was full)
+ *******************************************************/
+static uint16_t           __event_dropped;
+static callback_t         __event_hook;
+
+#define PSW_TIMING(sw)  ((sw)->timing != NULL ? (sw)->timing : &__default_timing)
+
+/*******************************************************
+ * Vertical counter debouncer (one bit per key)
+ * - __cnt0/__cnt1: 2-bit counters of the differing samples.
+ * - __debounced:   Debounced keys (1: ON).
+ * - __busy:        Keys that are not in the KEY_OFF state.
+ * - __sample_ticks: Ticks to the next sample.
+ * - __waiting:     Sampling is stopped, waiting for the CN interrupt.
+ *******************************************************/
+static uint8_t          __cnt0;
+static uint8_t          __cnt1;
+static uint8_t          __debounced;
+static uint8_t          __busy;
+static uint16_t         __sample_ticks;
+static volatile bool    __waiting;
+
+
+/************************************************************
+ * __psw_wait_change
+ * Stops the sampling and enables the CN interrupt of the keys.
+ * An edge that occurred after the last sample cancels it.
+ ************************************************************/
+static void __psw_wait_change(void) {
+
+    uint8_t sample;
+
+    PSW0_CNEN = 1;
+    PSW1_CNEN = 1;
+    PSW2_CNEN = 1;
+    PSW3_CNEN = 1;
+    IPC4bits.CNIP = PSW_CN_ISR_PRIORITY;
+
+    __waiting     = true;
+    IFS1bits.CNIF = 0;
+    IEC1bits.CNIE = 1;
+
+    sample = (uint8_t)(~PSW_PORT >> PSW_PORT_SHIFT) & 0x0F;
+    if( sample != __debounced ) {
+        IEC1bits.CNIE = 0;
+        __waiting     = false;
+    }
+}
+
+
+/************************************************************
+ * Psw_IsIdle
+ ************************************************************/
+bool Psw_IsIdle(void) {
+    return __waiting;
+}
+
+
+/************************************************************
+ * __psw_debounce
+ * Samples the PSW_PORT once and debounces all keys.
+ * Returns the keys whose debounced state changed.
+ ************************************************************/
+static uint8_t __psw_debounce(void) {
+
+    uint8_t sample, delta, toggle;
+
+    sample = (uint8_t)(~PSW_PORT >> PSW_PORT_SHIFT) & 0x0F;
+
+    // The counter of a key counts while its sample differs
+    // from the debounced state, and is cleared otherwise.
+    delta  = sample ^ __debounced;
+    __cnt1 = (__cnt1 ^ __cnt0) & delta;
+    __cnt0 = ~__cnt0 & delta;
+
+    // The key toggles when its counter rolls over.
+    toggle = delta & ~(__cnt0 | __cnt1);
+    __debounced ^= toggle;
+    return toggle;
+}
+
+
+/************************************************************
+ * __psw_finite_state_machine
+ * Performs the state transition of the key.
+ * The edge is true if the debounced key state has just changed.
+ ************************************************************/
+static void __psw_finite_state_machine(switch_t *sw, uint8_t bit, bool edge) {
+
+    const psw_timing_t *t = PSW_TIMING(sw);
+
+    sw->onoff = (__debounced & bit) != 0;
+
+    /*********************************
+     * Debounced edges
+     *********************************/
+    if( edge ) {
+        if( sw->onoff ) {
+            // The key has been ON for the debouncing time already.
+            sw->state    = PSW_STATE_DOWN;
+            sw->onticks  = PSW_STATE_CHANGED_TICKS;
+            sw->offticks = 0;
+            sw->changed  = true;
+            sw->chorded  = false;
+            __busy      |= bit;
+        }
+        else if( sw->state != PSW_STATE_OFF && sw->state != PSW_STATE_UP ) {
+            // Only a short press, not a part of a chord, is a click.
+            // The clicks are counted for the callback or the event hook.
+            if( sw->state == PSW_STATE_DOWN && !sw->chorded && t->click_ticks > 0 &&
+                (sw->click_callback != NULL || __event_hook != NULL) && sw->clicks < 0xFF ) {
+                sw->clicks++;
+            }
+            else {
+                sw->clicks = 0;
+            }
+            sw->state    = PSW_STATE_UP;
+            sw->offticks = PSW_STATE_CHANGED_TICKS;
+            sw->changed  = true;
+        }
+        return;
+    }
+
+    /*********************************
+     * Key is ON: DOWN -> HOLD -> LOCK
+     *********************************/
+    if( sw->onoff ) {
+        sw->onticks++;
+        if( sw->state == PSW_STATE_DOWN ) {
+            if( sw->onticks >= t->hold_ticks ) {
+                sw->state   = PSW_STATE_HOLD;
+                sw->changed = true;
+            }
+        }
+        else if( sw->state == PSW_STATE_HOLD ) {
+            if( sw->onticks >= t->lock_ticks ) {
+                sw->state    = PSW_STATE_LOCK;
+                sw->changed  = true;
+                sw->onticks  = 0;
+                sw->offticks = t->pulse_max_ticks;  // Pulse interval.
+            }
+        }
+        else if( sw->state == PSW_STATE_LOCK ) {
+            if( sw->onticks >= sw->offticks ) {
+                sw->changed = true;
+                sw->onticks = 0;
+                if( sw->offticks > t->pulse_min_ticks ) {
+                    sw->offticks -= t->pulse_dec_ticks;
+                }
+            }
+        }
+        return;
+    }
+
+    /*********************************
+     * Key is OFF: UP -> OFF, and the
+     * end of the multi-click
+     *********************************/
+    sw->offticks++;
+    if( sw->state == PSW_STATE_UP && sw->offticks >= 2*PSW_STATE_CHANGED_TICKS ) {
+        sw->state = PSW_STATE_OFF;
+    }
+    if( sw->clicks > 0 && sw->offticks >= t->click_ticks ) {
+        sw->clicked = sw->clicks;
+        sw->clicks  = 0;
+    }
+    if( sw->state == PSW_STATE_OFF && sw->clicks == 0 ) {
+        __busy &= ~bit;
+    }
+}
+
+
+/************************************************************
+ * __psw_update_object_parameters
+ * Updates the switch object and fills the switch event.
+ ************************************************************/
+static void __psw_update_object_parameters(switch_t *sw, int id, switch_event_t *evt) {
+
+    sw->id   = id;
+    sw->data = __debounced;
+
+    if( sw->state == PSW_STATE_DOWN ) {
+        sw->sname = "KEY_DOWN";
+    }
+    else if( sw->state == PSW_STATE_HOLD ) {
+        sw->sname = "KEY_HOLD";
+    }
+    else if( sw->state == PSW_STATE_LOCK ) {
+        sw->sname = "KEY_LOCK";
+    }
+    else if( sw->state == PSW_STATE_UP ) {
+        sw->sname = "KEY_UP";
+    }
+    else if( sw->state == PSW_STATE_OFF ) {
+        sw->sname = "KEY_OFF";
+    }
+
+    evt->type   = EVT_SWITCH_PSW;
+    evt->id     = sw->id;
+    evt->state  = sw->state;
+    evt->sname  = sw->sname;
+    evt->sender = sw;
+    evt->clicks = 0;
+    evt->keys   = sw->data;
+}
+
+
+/************************************************************
+ * __psw_post
+ * Posts the callback of the event to the dispatcher.
+ ************************************************************/
+static void __psw_post(callback_t callback, switch_event_t *evt) {
+    if( callback != NULL && !Dispatch_Post(callback, evt, sizeof(switch_event_t)) ) {
+        __event_dropped++;
+    }
+}
+
+
+/************************************************************
+ * __psw_dispatch
+ * Passes the event to the hook and posts its callback.
+ ************************************************************/
+static void __psw_dispatch(switch_event_t *evt) {
+
+    switch_t *sw = evt->sender;
+
+    if( __event_hook != NULL ) {
+        __event_hook(evt);
+    }
+
+    if( evt->state == PSW_STATE_CHORD ) {
+        __psw_post(__chord_callback, evt);
+    }
+    else if( evt->state == PSW_STATE_CLICK ) {
+        __psw_post(sw->click_callback, evt);
+    }
+    else if( evt->state == PSW_STATE_DOWN && sw->down_callback != NULL ) {
+        __psw_post(sw->down_callback, evt);
+    }
+    else if( evt->state == PSW_STATE_HOLD && sw->hold_callback != NULL ) {
+        __psw_post(sw->hold_callback, evt);
+    }
+    else if( evt->state == PSW_STATE_LOCK && sw->lock_callback != NULL ) {
+        __psw_post(sw->lock_callback, evt);
+    }
+    else if( evt->state == PSW_STATE_UP && sw->up_callback != NULL ) {
+        __psw_post(sw->up_callback, evt);
+    }
+    else {
+        __psw_post(sw->change_callback, evt);
+    }
+}
+
+
+/************************************************************
+ * __psw_push
+ * Builds the event of the key and dispatches it. The event
+ * is copied once, into the queue of the dispatcher.
+ ************************************************************/
+static void __psw_push(switch_t *sw, int id, uint16_t state, char *sname, uint16_t clicks, uint8_t keys) {
+
+    switch_event_t evt;
+
+    __psw_update_object_parameters(sw, id, &evt);
+    if( sname != NULL ) {
+        evt.state  = state;
+        evt.sname  = sname;
+        evt.clicks = clicks;
+        evt.keys   = keys;
+    }
+    CLOCK_STAMP(evt.timestamp);
+    __psw_dispatch(&evt);
+}
+
+
+/************************************************************
+ * __psw_chord
+ * Emits the chord event if the key is pressed within its
+ * chord_ticks after other keys that are still down.
+ ************************************************************/
+static void __psw_chord(switch_t *sw, int id, uint8_t bit) {
+
+    const psw_timing_t *t = PSW_TIMING(sw);
+    uint8_t             keys = 0, mask, other;
+    int                 j;
+
+    if( (__chord_callback == NULL && __event_hook == NULL) || t->chord_ticks == 0 ) {
+        return;
+    }
+
+    mask = __debounced & ~bit;
+    while( mask != 0 ) {
+        j     = __builtin_ff1r(mask) - 1;
+        other = 1u << j;
+        mask &= ~other;
+        if( switches[j].state == PSW_STATE_DOWN &&
+            switches[j].onticks <= PSW_STATE_CHANGED_TICKS + t->chord_ticks ) {
+            keys |= other;
+        }
+    }
+    if( keys == 0 ) {
+        return;
+    }
+    keys |= bit;
+
+    // Keys of the chord are not clicks.
+    mask = keys;
+    while( mask != 0 ) {
+        j     = __builtin_ff1r(mask) - 1;
+        mask &= ~(1u << j);
+        switches[j].chorded = true;
+        switches[j].clicks  = 0;
+    }
+
+    __psw_push(sw, id, PSW_STATE_CHORD, "KEY_CHORD", 0, keys);
+}
+
+
+/************************************************************
+ * __psw_set_callback
+ * Sets the callback function of the state and its flag.
+ ************************************************************/
+static bool __psw_set_callback(int16_t id, uint8_t flag, callback_t callback) {
+
+    switch_t *sw;
+
+    if( id < 0 || id >= PSW_MAX_KEYS ) {
+        return false;
+    }
+    sw = &switches[id];
+
+    switch( flag ) {
+        case PSW_STATE_DOWN:    sw->down_callback   = callback; break;
+        case PSW_STATE_HOLD:    sw->hold_callback   = callback; break;
+        case PSW_STATE_LOCK:    sw->lock_callback   = callback; break;
+        case PSW_STATE_UP:      sw->up_callback     = callback; break;
+        case PSW_STATE_CLICK:   sw->click_callback  = callback; break;
+        default:                sw->change_callback = callback; break;
+    }
+
+    if( callback != NULL ) {
+        sw->callback_flags |= flag;
+    }
+    else {
+        sw->callback_flags &= ~flag;
+    }
+    return true;
+}
+
+
+/************************************************************
+ * Psw_SetKeyDownCallback
+ ************************************************************/
+bool Psw_SetKeyDownCallback(int16_t id, callback_t callback) {
+    return __psw_set_callback(id, PSW_STATE_DOWN, callback);
+}
+
+
+/************************************************************
+ * Psw_SetKeyHoldCallback
+ ************************************************************/
+bool Psw_SetKeyHoldCallback(int16_t id, callback_t callback) {
+    return __psw_set_callback(id, PSW_STATE_HOLD, callback);
+}
+
+
+/************************************************************
+ * Psw_SetKeyLockCallback
+ ************************************************************/
+bool Psw_SetKeyLockCallback(int16_t id, callback_t callback) {
+    return __psw_set_callback(id, PSW_STATE_LOCK, callback);
+}
+
+
+/************************************************************
+ * Psw_SetKeyUpCallback
+ ************************************************************/
+bool Psw_SetKeyUpCallback(int16_t id, callback_t callback) {
+    return __psw_set_callback(id, PSW_STATE_UP, callback);
+}
+
+
+/************************************************************
+ * Psw_SetKeyChangedCallback
+ ************************************************************/
+bool Psw_SetKeyChangedCallback(int16_t id, callback_t callback) {
+    return __psw_set_callback(id, PSW_STATE_CHANGE, callback);
+}
+
+
+/************************************************************
+ * Psw_SetKeyClickCallback
+ ************************************************************/
+bool Psw_SetKeyClickCallback(int16_t id, callback_t callback) {
+    return __psw_set_callback(id, PSW_STATE_CLICK, callback);
+}
+
+
+/************************************************************
+ * Psw_SetChordCallback
+ ************************************************************/
+void Psw_SetChordCallback(callback_t callback) {
+    __chord_callback = callback;
+}
+
+
+/************************************************************
+ * Psw_SetEventHook
+ ************************************************************/
+void Psw_SetEventHook(callback_t hook) {
+    __event_hook = hook;
+}
+
+
+/************************************************************
+ * Psw_GetDroppedEvents
+ ************************************************************/
+uint16_t Psw_GetDroppedEvents(void) {
+    return __event_dropped;
+}
+
+
+/************************************************************
+ * Psw_SetTiming
+ ************************************************************/
+bool Psw_SetTiming(int16_t id, const psw_timing_t *timing) {
+    if( id < 0 || id >= PSW_MAX_KEYS ) {
+        return false;
+    }
+    switches[id].timing = timing;
+    return true;
+}
+
+
+/************************************************************
+ * PSW_KeyTickedExecutor
+ ************************************************************/
+inline void PSW_KeyTickedExecutor(void) {
+
+    switch_t       *sw;
+    uint8_t         edges = 0, mask, bit;
+    int             id;
+
+    /*********************************
+     * All keys are released, the CN
+     * interrupt resumes the sampling
+     *********************************/
+    if( __waiting ) {
+        return;
+    }
+
+    /*********************************
+     * One port read for all keys
+     *********************************/
+    if( ++__sample_ticks >= PSW_DEBOUNCE_SAMPLE_TICKS ) {
+        __sample_ticks = 0;
+        edges = __psw_debounce();
+    }
+
+    /*********************************
+     * Nothing to do when all keys are
+     * OFF and no edge is detected
+     *********************************/
+    mask = __busy | edges;
+    while( mask != 0 ) {
+        id    = __builtin_ff1r(mask) - 1;
+        bit   = 1u << id;
+        mask &= ~bit;
+        sw    = &switches[id];
+
+        __psw_finite_state_machine(sw, bit, (edges & bit) != 0);
+
+        /*********************************
+         * State changed
+         *********************************/
+        if( sw->changed ) {
+            sw->changed = false;
+
+            if( sw->state == PSW_STATE_DOWN && (edges & bit) ) {
+                __psw_chord(sw, id, bit);
+            }
+            if( sw->callback_flags != 0 || __event_hook != NULL ) {
+                __psw_push(sw, id, 0, NULL, 0, 0);
+            }
+        }
+
+        /*********************************
+         * End of a multi-click
+         *********************************/
+        if( sw->clicked > 0 ) {
+            __psw_push(sw, id, PSW_STATE_CLICK, "KEY_CLICK", sw->clicked, __debounced);
+            sw->clicked = 0;
+        }
+    }
+
+    /*********************************
+     * Released and debounced
+     *********************************/
+    if( __busy == 0 && (__cnt0 | __cnt1) == 0 ) {
+        __psw_wait_change();
+    }
+}
+
+
+/************************************************************
+ * CN Interrupt Service Routine
+ * An edge on one of the keys resumes the sampling, so the key
+ * is debounced for the same time as in the polling mode.
+ ************************************************************/
+void __attribute__((interrupt, auto_psv)) _CNInterrupt(void) {
+    IEC1bits.CNIE  = 0;
+    IFS1bits.CNIF  = 0;
+    __sample_ticks = 0;
+    __waiting      = false;
+}
@@ -45,5 +45,13 @@
     #define ECC_SYSTEM_USE_RTL      0
 #endif
 
+/************************************************************
+ * RTL configuration
+ * Number of timers in the pool of the Timer_Create().
+ * Size it to the timers of the application, each timer
+ * takes sizeof(timer_t) bytes of RAM.
+ ************************************************************/
+#define RTL_CONFIG_MAX_TIMERS       10
+
 
 #endif // ECC_APP_CONFIGURATION
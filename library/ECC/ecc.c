@@ -18,10 +18,14 @@
  * Hardware timer (TIMER1) ISR
  ************************************************************/
 void __attribute__((__interrupt__, auto_psv)) _T1Interrupt/*configTICK_INTERRUPT_HANDLER*/( void ) {
+	PROFILE_BEGIN(PROFILE_SITE_TICK_ISR);
 	IFS0bits.T1IF = 0;
 	if( xTaskIncrementTick() != pdFALSE ) {
+		PROFILE_END(PROFILE_SITE_TICK_ISR);
 		portYIELD();
+		return;
 	}
+	PROFILE_END(PROFILE_SITE_TICK_ISR);
 }
 
 
@@ -44,17 +48,62 @@ void vApplicationTickHook( void ) {
     /*********************************
      * BSP_TickIsrExecutor
      *********************************/
+    PROFILE_BEGIN(PROFILE_SITE_BSP_TICK_ISR);
     BSP_TickIsrExecutor();  // Executes the BSP tick.
+    PROFILE_END(PROFILE_SITE_BSP_TICK_ISR);
 
     /*********************************
      * RTL_TickIsrExecutor
      *********************************/
 	#if ECC_SYSTEM_USE_RTL > 0
+       PROFILE_BEGIN(PROFILE_SITE_RTL_TICK_ISR);
        RTL_TickIsrExecutor();  // Executes the RTL tick.
+       PROFILE_END(PROFILE_SITE_RTL_TICK_ISR);
 	#endif
 }
 
 
+#if configUSE_TICKLESS_IDLE == 1
+
+#if BSP_TICKLESS_IDLE == 0
+    #error "The BSP_TICKLESS_IDLE (BSP_Config.h) must match the configUSE_TICKLESS_IDLE"
+#endif
+
+/************************************************************
+ * RTOS configPRE_SLEEP_PROCESSING.
+ * The tick can only be suppressed while the BSP and the RTL
+ * are idle, up to the earliest of their deadlines.
+ ************************************************************/
+void vApplicationPreSleepProcessing( TickType_t *pxExpectedIdleTime ) {
+    TickType_t xIdleTicks = BSP_GetIdleTicks();
+
+    #if ECC_SYSTEM_USE_RTL > 0
+        TickType_t xRtlTicks = RTL_GetIdleTicks();
+        if( xRtlTicks < xIdleTicks ) {
+            xIdleTicks = xRtlTicks;
+        }
+    #endif
+
+    if( *pxExpectedIdleTime > xIdleTicks ) {
+        *pxExpectedIdleTime = xIdleTicks;
+    }
+}
+
+
+/************************************************************
+ * RTOS configPOST_SLEEP_PROCESSING.
+ * The suppressed ticks are executed by the BSP_Executor and
+ * the RTL_Executor.
+ ************************************************************/
+void vApplicationPostSleepProcessing( TickType_t xSteppedTicks ) {
+    BSP_TickIsrAddTicks( xSteppedTicks );
+    #if ECC_SYSTEM_USE_RTL > 0
+        RTL_TickIsrAddTicks( xSteppedTicks );
+    #endif
+}
+#endif
+
+
 /************************************************************
  * RTOS vApplicationStackOverflowHook.
  ************************************************************/
@@ -69,19 +118,75 @@ void vApplicationStackOverflowHook (TaskHandle_t pxTask, char *pcTaskName ) {
 
 /************************************************************
  * CoRoutine executed by FreeRTOS.
+ * It runs in the idle task, its work is accounted as busy
+ * by the load meter (configUSE_LOAD_TRACE).
  ************************************************************/
 void System_CoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex ) {
     crSTART(xHandle);   	// Start co-routine
     for(;;) {
+        #if configUSE_LOAD_TRACE > 0
+            Load_IdleExit();
+        #endif
         BSP_Executor(); 	// Executes the BSP module.
         #if ECC_SYSTEM_USE_RTL > 0
 	    	RTL_Executor();	// Executes the RTL module.
 		#endif
+        #if configUSE_LOAD_TRACE > 0
+            Load_IdleEnter();
+        #endif
+        crDELAY(xHandle, 0);    // Returns to the idle task (tickless idle).
     }
     crEND();            	// End co-routine
 }
 
 
+/************************************************************
+ * Queue and event group of the switch events.
+ ************************************************************/
+static QueueHandle_t      key_queue = NULL;
+static EventGroupHandle_t key_group = NULL;
+
+
+/************************************************************
+ * Posts the switch event to the RTOS. It is called from the
+ * PSW_KeyTickedExecutor (co-routine), so it must not block.
+ ************************************************************/
+static void System_KeyEventHook( void *evt ) {
+    switch_event_t *key = (switch_event_t *)evt;
+
+    if( key_queue != NULL ) {
+        xQueueSend( key_queue, key, 0 );
+    }
+    if( key_group != NULL ) {
+        if( key->state == PSW_STATE_DOWN ) {
+            xEventGroupSetBits( key_group, SYSTEM_KEY_BIT_DOWN(key->id) );
+        }
+        else if( key->state == PSW_STATE_UP ) {
+            xEventGroupSetBits( key_group, SYSTEM_KEY_BIT_UP(key->id) );
+        }
+    }
+}
+
+
+/************************************************************
+ * Sets the queue of the switch events.
+ * The item size of the queue must be sizeof(switch_event_t).
+ ************************************************************/
+void System_SetKeyQueue( QueueHandle_t queue ) {
+    key_queue = queue;
+    Psw_SetEventHook( System_KeyEventHook );
+}
+
+
+/************************************************************
+ * Sets the event group of the switch events.
+ ************************************************************/
+void System_SetKeyEventGroup( EventGroupHandle_t group ) {
+    key_group = group;
+    Psw_SetEventHook( System_KeyEventHook );
+}
+
+
 /************************************************************
  * Create a CoRoutine for BSP_Executor and RTL_Executor.
  ************************************************************/
@@ -98,6 +203,7 @@ void System_StartCoRutine( void ) {
  * ISR of Timer1 (System timer)
  *******************************************************/
 void __attribute__((interrupt, auto_psv)) _T1Interrupt( void ) {
+    PROFILE_BEGIN(PROFILE_SITE_TICK_ISR);
     IFS0bits.T1IF  = 0;
 
     /*********************************
@@ -108,13 +214,33 @@ void __attribute__((interrupt, auto_psv)) _T1Interrupt( void ) {
     /*********************************
      * BSP_TickIsrExecutor
      *********************************/
+	PROFILE_BEGIN(PROFILE_SITE_BSP_TICK_ISR);
 	BSP_TickIsrExecutor();
+	PROFILE_END(PROFILE_SITE_BSP_TICK_ISR);
 
     /*********************************
      * RTL_TickIsrExecutor
      *********************************/
 	#if ECC_SYSTEM_USE_RTL > 0
+        PROFILE_BEGIN(PROFILE_SITE_RTL_TICK_ISR);
         RTL_TickIsrExecutor();
+        PROFILE_END(PROFILE_SITE_RTL_TICK_ISR);
 	#endif
+
+    PROFILE_END(PROFILE_SITE_TICK_ISR);
+}
+
+
+/************************************************************
+ * System_IsPending
+ * It is also checked by the BSP_Idle() with the interrupts
+ * masked, e.g. a Bus_Publish() of an ISR is not missed.
+ ************************************************************/
+bool System_IsPending( void ) {
+    #if ECC_SYSTEM_USE_RTL > 0
+        return BSP_GetPending() != 0 || RTL_IsPending();
+    #else
+        return BSP_GetPending() != 0;
+    #endif
 }
 #endif
@@ -28,8 +28,35 @@
 
     #if ECC_SYSTEM_USE_RTOS > 0
         #include <rtos.h>
+        #include <event_groups.h>
         void System_StartCoRutine(void);
 
+        /************************************************************
+         * Switch events posted to the RTOS (see the ecc.c)
+         * - System_SetKeyQueue: Every switch event (switch_event_t)
+         *   is sent to the queue, tasks can block on the queue.
+         * - System_SetKeyEventGroup: The KEY_DOWN and KEY_UP events
+         *   set the bits below in the event group.
+         ************************************************************/
+        void System_SetKeyQueue(QueueHandle_t queue);
+        void System_SetKeyEventGroup(EventGroupHandle_t group);
+
+        #define SYSTEM_KEY_BIT_DOWN(id)     (1 << (id))         // Bits 0-3: KEY_DOWN of PSW_ID_0-3.
+        #define SYSTEM_KEY_BIT_UP(id)       (1 << ((id) + 4))   // Bits 4-7: KEY_UP of PSW_ID_0-3.
+
+        /************************************************************
+         * Tickless idle hooks (see the vPortSuppressTicksAndSleep)
+         * - vApplicationPreSleepProcessing: Limits the idle time to
+         *   the idle ticks of the BSP and the RTL (0 or 1 keeps the
+         *   tick running).
+         * - vApplicationPostSleepProcessing: Replays the suppressed
+         *   ticks to the BSP and the RTL.
+         ************************************************************/
+        #if configUSE_TICKLESS_IDLE == 1
+            void vApplicationPreSleepProcessing(TickType_t *pxExpectedIdleTime);
+            void vApplicationPostSleepProcessing(TickType_t xSteppedTicks);
+        #endif
+
         #define vTaskDelayMs(ms) vTaskDelay(ms / portTICK_PERIOD_MS)
 
     #endif
@@ -37,8 +64,13 @@
     #if ECC_SYSTEM_USE_RTOS > 0
         #define System_Init() {		        \
         	Mcu_Init();				        \
+            Clock_Init();                   \
+            Profile_Init();                 \
+            Load_Init();                    \
+            Dispatch_Init();                \
             Beep_Init();                    \
             Led_BlinkInit();                \
+            Led_DimInit();                  \
             Adc_Init();                     \
         }
         #define System_Start(){		        \
@@ -48,22 +80,52 @@
     #else
         #define System_Init() {		        \
         	Mcu_Init();				        \
+            Clock_Init();                   \
+            Profile_Init();                 \
+            Load_Init();                    \
+            Dispatch_Init();                \
             Beep_Init();                    \
             Led_BlinkInit();                \
+            Led_DimInit();                  \
             Adc_Init();                     \
         	System_TimerInit();		        \
         }
+        /************************************************************
+         * System_IsPending (ecc.c)
+         * Returns true if the BSP or the RTL has a pending work.
+         ************************************************************/
+        bool System_IsPending(void);
+
+        /************************************************************
+         * Main loop, the CPU is idle (see the BSP_Load.h) while
+         * neither the BSP nor the RTL has a pending work. The
+         * BSP_Executor is called on every pass, it polls the UARTs.
+         ************************************************************/
         #if ECC_SYSTEM_USE_RTL > 0
             #define System_Start(){		    \
             	while(1) {				    \
+                    if( System_IsPending() ) {\
+                        Load_IdleExit();    \
+                    }                       \
                     BSP_Executor();		    \
                     RTL_Executor();		    \
+                    if( !System_IsPending() ) {\
+                        Load_IdleEnter();   \
+                        BSP_Idle(System_IsPending);\
+                    }                       \
                 }						    \
             }
         #else
-           #define System_Start(){		    \
+            #define System_Start(){		    \
             	while(1) {				    \
+                    if( System_IsPending() ) {\
+                        Load_IdleExit();    \
+                    }                       \
                     BSP_Executor();		    \
+                    if( !System_IsPending() ) {\
+                        Load_IdleEnter();   \
+                        BSP_Idle(System_IsPending);\
+                    }                       \
                 }						    \
             }
         #endif
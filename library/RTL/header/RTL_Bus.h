@@ -0,0 +1,128 @@
+/************************************************************
+ * File:    RTL_Bus.h                                       *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __RTL_BUS_H__
+
+    #define __RTL_BUS_H__
+
+    #include <RTL_Config.h>
+
+    /*******************************************************
+     * EVENT BUS (publish/subscribe)
+     * An event is published to a topic, it is copied into
+     * the event ring and delivered to all subscribers of the
+     * topic by the RTL_Executor(). The events in the ring when
+     * the executor starts are delivered as one batch, the
+     * events published by the subscribers are delivered in
+     * the next batch.
+     *******************************************************/
+
+    /*******************************************************
+     * Topics of the BSP events (see the Bus_Bridge())
+     *******************************************************/
+    #define BUS_TOPIC_KEY       0   // switch_event_t (Psw_SetKeyChangedCallback).
+    #define BUS_TOPIC_ADC       1   // adc_event_t (Adc_SetChangedCallback).
+    #define BUS_TOPIC_UART1_RX  2   // uart_event_t (Uart1_SetRxCallback).
+    #define BUS_TOPIC_UART2_RX  3   // uart_event_t (Uart2_SetRxCallback).
+    #define BUS_TOPIC_BEEP      4   // beep_event_t (Beep_SetCallback).
+    #define BUS_TOPIC_LED       5   // led_event_t (Led_SetChangedCallback).
+    #define BUS_TOPIC_USER      6   // First topic of the application.
+
+    /*******************************************************
+     * Maximum size of the event copied into the ring
+     *******************************************************/
+    #ifndef BUS_EVENT_SIZE
+        #define BUS_EVENT_SIZE      24
+    #endif
+
+    /*******************************************************
+     * BUS EVENT STRUCTURE (passed to the subscribers)
+     *******************************************************/
+    typedef struct {
+        uint16_t    topic;      /* Topic of the event.              */
+        uint16_t    size;       /* Size of the data (bytes).        */
+        void        *data;      /* Published data (the copy).       */
+        void        *context;   /* Context of the subscriber.       */
+    }bus_event_t;
+
+
+    /*******************************************************
+     * Bus_Subscribe
+     * Adds the subscriber to the topic. A topic can have many
+     * subscribers, they are called in the subscribing order.
+     * Returns the handle of the subscription, or -1 if all
+     * RTL_CONFIG_BUS_SUBSCRIBERS are used.
+     * Parameters:
+     * - topic: Topic (0 - RTL_CONFIG_BUS_TOPICS-1).
+     * - callback: Callback function, its event is the bus_event_t.
+     * - context: Context of the subscriber (user data).
+     *******************************************************/
+    int16_t Bus_Subscribe(uint16_t topic, callback_t callback, void *context);
+
+
+    /*******************************************************
+     * Bus_Unsubscribe
+     * Removes the subscription.
+     * Parameters:
+     * - handle: Handle returned by the Bus_Subscribe().
+     *******************************************************/
+    void Bus_Unsubscribe(int16_t handle);
+
+
+    /*******************************************************
+     * Bus_Publish
+     * Copies the data into the event ring. An event without
+     * subscribers is not queued. It can be called from ISRs.
+     * Returns false if the ring is full or the data is larger
+     * than BUS_EVENT_SIZE (the event is dropped and counted).
+     * Parameters:
+     * - topic: Topic of the event.
+     * - data: Data of the event.
+     * - size: Size of the data (bytes).
+     *******************************************************/
+    bool Bus_Publish(uint16_t topic, const void *data, uint16_t size);
+
+
+    /*******************************************************
+     * Bus_Bridge
+     * Connects the callback of a BSP module to its topic,
+     * the BSP events are published to the bus.
+     * The string of the UART event is the line buffer of the
+     * UART, it is valid until the next line is received.
+     * Returns false if the topic is not a BSP topic.
+     * Parameters:
+     * - topic: BUS_TOPIC_KEY, _ADC, _UART1_RX, _UART2_RX,
+     *          _BEEP or _LED.
+     * - id: Id of the switch, ADC channel or LED (ignored by
+     *       the UART and beep topics).
+     *******************************************************/
+    bool Bus_Bridge(uint16_t topic, int16_t id);
+
+
+    /*******************************************************
+     * Bus_IsPending
+     * Returns true if an event is waiting in the ring.
+     *******************************************************/
+    bool Bus_IsPending(void);
+
+
+    /*******************************************************
+     * Bus_GetDropped
+     * Returns the number of dropped events (ring full).
+     *******************************************************/
+    uint16_t Bus_GetDropped(void);
+
+
+    /***********************************************************
+     * Bus_Executor
+     * Delivers one batch of the events.
+     * This function is called by the RTL_Executor().
+     ***********************************************************/
+    inline void Bus_Executor(void);
+
+#endif // __RTL_BUS_H__
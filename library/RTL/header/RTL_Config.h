@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  17 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __RTL_CONFIG_H__
@@ -12,7 +12,105 @@
 
     #include <BSP_Config.h>
 
+    /********************************************************
+     * Application configuration. The RTL_CONFIG_XXX can be
+     * defined in the app.h to override the defaults below.
+     * The app.h is optional if the compiler has the
+     * __has_include, otherwise it is required unless the
+     * RTL_CONFIG_NO_APP_H is defined (build flags). The
+     * application and the RTL sources must be built with
+     * the same configuration.
+     ********************************************************/
+    #ifndef RTL_CONFIG_NO_APP_H
+        #if defined(__has_include)
+            #if __has_include(<app.h>)
+                #include <app.h>
+            #endif
+        #else
+            #include <app.h>
+        #endif
+    #endif
 
-    #define RTL_CONFIG_MAX_TIMERS  10
+    /********************************************************
+     * Number of timers in the pool of the Timer_Create().
+     * The static timers (Timer_CreateStatic) are not counted.
+     ********************************************************/
+    #ifndef RTL_CONFIG_MAX_TIMERS
+        #define RTL_CONFIG_MAX_TIMERS  10
+    #endif
+
+    /********************************************************
+     * Alarms of the timers (RTL_Timer)
+     * 1: Posted to the dispatcher (BSP_Dispatch), the
+     *    callbacks are performed by the priorities of the
+     *    Dispatch_Register(), after the higher priority
+     *    switch/ADC callbacks.
+     * 0: Performed directly by the Timer_TickedExecutor().
+     ********************************************************/
+    #ifndef RTL_CONFIG_TIMER_DISPATCH
+        #define RTL_CONFIG_TIMER_DISPATCH  1
+    #endif
+
+    /********************************************************
+     * Number of the ISR timers (RTL_IsrTimer), up to 16.
+     ********************************************************/
+    #ifndef RTL_CONFIG_MAX_ISR_TIMERS
+        #define RTL_CONFIG_MAX_ISR_TIMERS  4
+    #endif
+
+    /********************************************************
+     * Number of exceeded budgets that stops an ISR timer.
+     * 0: The timers are never stopped, the exceeded budgets
+     *    are only counted.
+     ********************************************************/
+    #ifndef RTL_CONFIG_ISR_TIMER_OVERRUN_LIMIT
+        #define RTL_CONFIG_ISR_TIMER_OVERRUN_LIMIT  0
+    #endif
+
+    /********************************************************
+     * Event bus (RTL_Bus): number of the topics, the
+     * subscriptions and the events in the ring.
+     ********************************************************/
+    #ifndef RTL_CONFIG_BUS_TOPICS
+        #define RTL_CONFIG_BUS_TOPICS       16
+    #endif
+    #ifndef RTL_CONFIG_BUS_SUBSCRIBERS
+        #define RTL_CONFIG_BUS_SUBSCRIBERS  16
+    #endif
+    #ifndef RTL_CONFIG_BUS_QUEUE_LENGTH
+        #define RTL_CONFIG_BUS_QUEUE_LENGTH 8
+    #endif
+
+    /********************************************************
+     * Number of the event sources (bus topics and timers)
+     * bound to the state machines (RTL_Hsm).
+     ********************************************************/
+    #ifndef RTL_CONFIG_HSM_BINDINGS
+        #define RTL_CONFIG_HSM_BINDINGS     8
+    #endif
+
+    /********************************************************
+     * Fixed-point benchmark (RTL_Fixed), 1: Fixed_Benchmark()
+     * is compiled (it links the soft-float math library).
+     ********************************************************/
+    #ifndef RTL_CONFIG_FIXED_BENCHMARK
+        #define RTL_CONFIG_FIXED_BENCHMARK  0
+    #endif
+
+    /********************************************************
+     * PID loops (RTL_Pid): number of the loops (up to 16),
+     * priority of the Timer2 interrupt that performs them and
+     * the execution budget (uS) of one run. The exceeded
+     * budgets are only counted.
+     ********************************************************/
+    #ifndef RTL_CONFIG_PID_LOOPS
+        #define RTL_CONFIG_PID_LOOPS        2
+    #endif
+    #ifndef RTL_CONFIG_PID_ISR_PRIORITY
+        #define RTL_CONFIG_PID_ISR_PRIORITY 5
+    #endif
+    #ifndef RTL_CONFIG_PID_BUDGET_US
+        #define RTL_CONFIG_PID_BUDGET_US    100
+    #endif
 
 #endif // __RTL_CONFIG_H__
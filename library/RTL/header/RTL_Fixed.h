@@ -0,0 +1,128 @@
+/************************************************************
+ * File:    RTL_Fixed.h                                     *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __RTL_FIXED_H__
+
+    #define __RTL_FIXED_H__
+
+    #include <RTL_Config.h>
+
+    /*******************************************************
+     * FIXED-POINT MATH
+     * - q15_t: 1.15 fixed-point, -1.0 to 0.99997.
+     * - q31_t: 1.31 fixed-point, -1.0 to 0.9999999995.
+     * The arithmetic saturates instead of wrapping. The
+     * multiplications use the 16x16 hardware multiplier
+     * (MUL.SS/MUL.SU/MUL.UU) through the XC16 builtins.
+     * The angles are uint16_t, a full circle is 65536
+     * (FIXED_ANGLE_90 is 90 degrees).
+     *******************************************************/
+    typedef int16_t     q15_t;
+    typedef int32_t     q31_t;
+
+    /*******************************************************
+     * Limits
+     *******************************************************/
+    #define Q15_MAX     ((q15_t)0x7FFF)
+    #define Q15_MIN     ((q15_t)0x8000)
+    #define Q31_MAX     ((q31_t)0x7FFFFFFFL)
+    #define Q31_MIN     ((q31_t)0x80000000L)
+
+    /*******************************************************
+     * Constants from the real numbers (compile time only),
+     * 1.0 is saturated to the maximum.
+     *******************************************************/
+    #define Q15(x)      ((q15_t)((x) >= 1.0 ? 32767L : (x) * 32768.0 + ((x) >= 0 ? 0.5 : -0.5)))
+    #define Q31(x)      ((q31_t)((x) >= 1.0 ? 2147483647L : (x) * 2147483648.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+    /*******************************************************
+     * Conversions
+     *******************************************************/
+    #define Q15_TO_Q31(x)   ((q31_t)(x) << 16)
+    #define Q31_TO_Q15(x)   ((q15_t)((x) >> 16))
+
+    /*******************************************************
+     * Angles
+     *******************************************************/
+    #define FIXED_ANGLE_90      0x4000u
+    #define FIXED_ANGLE_180     0x8000u
+    #define FIXED_ANGLE_DEG(d)  ((uint16_t)((d) * 65536.0 / 360.0))
+
+
+    /*******************************************************
+     * Q15_Sat
+     * Saturates the 32-bit value to the q15_t.
+     *******************************************************/
+    q15_t Q15_Sat(int32_t x);
+
+
+    /*******************************************************
+     * Q15_Add, Q15_Sub, Q15_Mul, Q15_Div
+     * Saturating arithmetic of the q15_t.
+     * The Q15_Div() returns the saturated a/b.
+     *******************************************************/
+    q15_t Q15_Add(q15_t a, q15_t b);
+    q15_t Q15_Sub(q15_t a, q15_t b);
+    q15_t Q15_Mul(q15_t a, q15_t b);
+    q15_t Q15_Div(q15_t a, q15_t b);
+
+
+    /*******************************************************
+     * Q31_Add, Q31_Sub, Q31_Mul, Q31_MulQ15
+     * Saturating arithmetic of the q31_t. The Q31_Mul() uses
+     * three 16x16 multiplications (the low x low product is
+     * omitted, the error is below 3 LSB).
+     *******************************************************/
+    q31_t Q31_Add(q31_t a, q31_t b);
+    q31_t Q31_Sub(q31_t a, q31_t b);
+    q31_t Q31_Mul(q31_t a, q31_t b);
+    q31_t Q31_MulQ15(q31_t a, q15_t b);
+
+
+    /*******************************************************
+     * Q15_Sin, Q15_Cos
+     * Sine and cosine of the angle, by the quarter-wave table
+     * (256 steps) with the linear interpolation.
+     *******************************************************/
+    q15_t Q15_Sin(uint16_t angle);
+    q15_t Q15_Cos(uint16_t angle);
+
+
+    /*******************************************************
+     * Fixed_Sqrt32
+     * Returns the integer square root of the value.
+     *******************************************************/
+    uint16_t Fixed_Sqrt32(uint32_t x);
+
+
+    /*******************************************************
+     * Q15_Sqrt
+     * Returns the square root of the q15_t (0 for negatives).
+     *******************************************************/
+    q15_t Q15_Sqrt(q15_t x);
+
+
+    /*******************************************************
+     * Fixed_Atan2
+     * Returns the angle of the vector (x, y), 0 - 65535.
+     * The error is below 0.3 degree.
+     *******************************************************/
+    uint16_t Fixed_Atan2(int16_t y, int16_t x);
+
+
+    /*******************************************************
+     * Fixed_Benchmark
+     * Prints the instruction cycles of the fixed-point and the
+     * soft-float operations to the UART1 (Timer5 at 1:1).
+     * Only available if RTL_CONFIG_FIXED_BENCHMARK is 1.
+     *******************************************************/
+    #if RTL_CONFIG_FIXED_BENCHMARK > 0
+        void Fixed_Benchmark(void);
+    #endif
+
+#endif // __RTL_FIXED_H__
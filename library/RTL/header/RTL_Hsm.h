@@ -0,0 +1,205 @@
+/************************************************************
+ * File:    RTL_Hsm.h                                       *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __RTL_HSM_H__
+
+    #define __RTL_HSM_H__
+
+    #include <RTL_Config.h>
+    #include <RTL_Timer.h>
+    #include <RTL_Bus.h>
+
+    /*******************************************************
+     * HIERARCHICAL STATE MACHINE (table-driven)
+     * The states and the transitions are const tables (kept
+     * in the flash, read through the PSV). The transition of
+     * an event is found by indexing the table of the state
+     * with the event id, an event that is not handled by the
+     * state is passed to its parent state.
+     * A transition exits the states up to the common parent
+     * of the source and the target, then enters the states
+     * down to the target and its initial sub-states.
+     *
+     * Example:
+     *   enum { ST_ON, ST_SLOW, ST_FAST, ST_OFF };
+     *   enum { EV_KEY, EV_TICK, EV_COUNT };
+     *   const hsm_state_t states[] = {
+     *       // parent     initial    entry     exit
+     *       { HSM_NONE,   ST_SLOW,   On_Entry, NULL },   // ST_ON
+     *       { ST_ON,      HSM_NONE,  NULL,     NULL },   // ST_SLOW
+     *       { ST_ON,      HSM_NONE,  NULL,     NULL },   // ST_FAST
+     *       { HSM_NONE,   HSM_NONE,  Off_Entry,NULL },   // ST_OFF
+     *   };
+     *   const hsm_transition_t transitions[][EV_COUNT] = {
+     *       //  EV_KEY                 EV_TICK
+     *       { { ST_OFF, NULL },     { HSM_NONE, NULL } },          // ST_ON
+     *       { { ST_FAST, NULL },    { HSM_INTERNAL, Blink } },     // ST_SLOW
+     *       { { HSM_NONE, NULL },   { HSM_INTERNAL, Blink } },     // ST_FAST
+     *       { { ST_ON, NULL },      { HSM_NONE, NULL } },          // ST_OFF
+     *   };
+     *   const hsm_def_t def = { states, &transitions[0][0], 4, EV_COUNT, ST_ON };
+     *******************************************************/
+
+    /*******************************************************
+     * Special states of the tables
+     *******************************************************/
+    #define HSM_NONE        0xFF    // No state (no parent, no initial sub-state, not handled).
+    #define HSM_INTERNAL    0xFE    // Internal transition, only the action is performed.
+
+    /*******************************************************
+     * Maximum depth of the state hierarchy
+     *******************************************************/
+    #ifndef HSM_MAX_DEPTH
+        #define HSM_MAX_DEPTH   8
+    #endif
+
+    struct hsm_s;
+
+    /*******************************************************
+     * Entry/exit handler of a state
+     *******************************************************/
+    typedef void (*hsm_handler_t)(struct hsm_s *sm);
+
+    /*******************************************************
+     * Action of a transition. It is performed before the
+     * exits, it returns false to reject the transition (guard),
+     * the event is then passed to the parent state.
+     *******************************************************/
+    typedef bool (*hsm_action_t)(struct hsm_s *sm, uint8_t event, void *data);
+
+    /*******************************************************
+     * STATE STRUCTURE (const table)
+     *******************************************************/
+    typedef struct {
+        uint8_t         parent;     /* Parent state, or HSM_NONE.           */
+        uint8_t         initial;    /* Initial sub-state, or HSM_NONE.      */
+        hsm_handler_t   entry;      /* Entry handler, or NULL.              */
+        hsm_handler_t   exit;       /* Exit handler, or NULL.               */
+    }hsm_state_t;
+
+    /*******************************************************
+     * TRANSITION STRUCTURE (const table)
+     *******************************************************/
+    typedef struct {
+        uint8_t         target;     /* Target, HSM_INTERNAL or HSM_NONE.    */
+        hsm_action_t    action;     /* Action (guard), or NULL.             */
+    }hsm_transition_t;
+
+    /*******************************************************
+     * STATE MACHINE DEFINITION (const)
+     * The transitions are [state_count][event_count].
+     *******************************************************/
+    typedef struct {
+        const hsm_state_t       *states;        /* States.                      */
+        const hsm_transition_t  *transitions;   /* Transitions of the states.   */
+        uint8_t                 state_count;    /* Number of the states.        */
+        uint8_t                 event_count;    /* Number of the events.        */
+        uint8_t                 initial;        /* Initial state.               */
+    }hsm_def_t;
+
+    /*******************************************************
+     * STATE MACHINE OBJECT STRUCTURE (RAM)
+     *******************************************************/
+    typedef struct hsm_s {
+        const hsm_def_t *def;       /* Definition of the machine.           */
+        uint8_t         state;      /* Current (leaf) state.                */
+        void            *context;   /* Context of the machine (user data).  */
+    }hsm_t;
+
+
+    /*******************************************************
+     * Hsm_Init
+     * Initializes the machine and enters its initial state.
+     * Returns false if the tables are invalid, the machine
+     * is not started and it handles no event:
+     * - A state is deeper than HSM_MAX_DEPTH (or a parent
+     *   cycle, a parent out of the state_count).
+     * - An initial sub-state is not a direct child of its
+     *   state, or the initial state is out of the state_count.
+     * - A transition target is not a state, HSM_NONE or
+     *   HSM_INTERNAL.
+     * Parameters:
+     * - sm: State machine object.
+     * - def: Definition of the machine (const).
+     * - context: Context of the machine (user data).
+     *******************************************************/
+    bool Hsm_Init(hsm_t *sm, const hsm_def_t *def, void *context);
+
+
+    /*******************************************************
+     * Hsm_Dispatch
+     * Dispatches the event to the machine (run to completion).
+     * The actions must not dispatch to the same machine, use
+     * the Bus_Publish() instead.
+     * Returns true if the event is handled.
+     * Parameters:
+     * - sm: State machine object.
+     * - event: Event id (0 - event_count-1).
+     * - data: Data of the event, passed to the action.
+     *******************************************************/
+    bool Hsm_Dispatch(hsm_t *sm, uint8_t event, void *data);
+
+
+    /*******************************************************
+     * Hsm_IsIn
+     * Returns true if the machine is in the state or in one
+     * of its sub-states.
+     *******************************************************/
+    bool Hsm_IsIn(hsm_t *sm, uint8_t state);
+
+
+    /*******************************************************
+     * Hsm_BindTopic
+     * Dispatches the events of the bus topic to the machine
+     * as the given event, the data is the bus event data.
+     * Returns false if no binding (RTL_CONFIG_HSM_BINDINGS)
+     * or subscription is available.
+     *******************************************************/
+    bool Hsm_BindTopic(hsm_t *sm, uint16_t topic, uint8_t event);
+
+
+    /*******************************************************
+     * Hsm_UnbindTopic
+     * Removes the bindings of the bus topic to the machine,
+     * their subscriptions and bindings are freed.
+     *******************************************************/
+    void Hsm_UnbindTopic(hsm_t *sm, uint16_t topic);
+
+
+    /*******************************************************
+     * Hsm_CreateTimer
+     * Creates a timer that dispatches the given event to the
+     * machine, the data is the timer_event_t.
+     * Returns NULL if no binding or timer is available.
+     * Parameters:
+     * - sm: State machine object.
+     * - interval: Interval of the timer (milliseconds).
+     * - event: Event id of the alarms.
+     * - mode: TIMER_MODE_PERIODIC or TIMER_MODE_ONESHOT.
+     *******************************************************/
+    timer_t * Hsm_CreateTimer(hsm_t *sm, uint32_t interval, uint8_t event, uint8_t mode);
+
+
+    /*******************************************************
+     * Hsm_DeleteTimer
+     * Deletes the timer of the Hsm_CreateTimer() and frees
+     * its binding, use it instead of the Timer_Delete().
+     * An alarm that is already posted is not dispatched
+     * (unless the timer is re-created by a new binding first).
+     *******************************************************/
+    void Hsm_DeleteTimer(timer_t *timer);
+
+
+    /*******************************************************
+     * Hsm_Unbind
+     * Removes all bindings of the machine (topics and timers),
+     * e.g. before the machine object is reused or destroyed.
+     *******************************************************/
+    void Hsm_Unbind(hsm_t *sm);
+
+#endif // __RTL_HSM_H__
@@ -0,0 +1,135 @@
+/************************************************************
+ * File:    RTL_IsrTimer.h                                  *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __RTL_ISR_TIMER_H__
+
+    #define __RTL_ISR_TIMER_H__
+
+    #include <RTL_Config.h>
+    #include <BSP_Clock.h>
+
+    /*******************************************************
+     * ISR TIMERS
+     * The callbacks of the ISR timers are performed directly
+     * in the RTL_TickIsrExecutor() (the system tick interrupt),
+     * the jitter does not depend on the main loop.
+     * The callbacks must be short, they are measured by the
+     * Timer5 clock (BSP_Clock). The measured time is the wall
+     * clock time, it includes the nested interrupts of the
+     * higher priorities (UART, CN, Timer4, Timer5) that occur
+     * during the callback. The exceeded budgets are counted,
+     * a timer is only stopped when the non-zero
+     * RTL_CONFIG_ISR_TIMER_OVERRUN_LIMIT is reached.
+     * In the RTOS mode, only the FromISR functions of the
+     * FreeRTOS can be used in the callbacks.
+     *******************************************************/
+
+    #define EVT_ISR_TIMER_ALARM     0
+
+    /*******************************************************
+     * Maximum budget of a callback (uS), the execution time
+     * is measured by the 16-bit counts of the Timer5.
+     *******************************************************/
+    #define ISR_TIMER_MAX_BUDGET_US (0xFFFFu >> CLOCK_US_SHIFT)
+
+    /*******************************************************
+     * ISR TIMER OBJECT STRUCTURE
+     *******************************************************/
+    typedef struct {
+        int         id;         /* Id of the timer, 0, 1, ...           */
+        uint16_t    interval;   /* Alarm interval in ticks.             */
+        uint16_t    ticks;      /* Ticks to the next alarm.             */
+        uint16_t    counter;    /* Alarmed counter value.               */
+        uint16_t    budget;     /* Budget (Timer5 counts), 0: none.     */
+        uint16_t    last_us;    /* Last execution time (uS).            */
+        uint16_t    max_us;     /* Maximum execution time (uS).         */
+        uint16_t    overruns;   /* Number of exceeded budgets.          */
+        callback_t  callback;   /* Callback function.                   */
+        void        *context;   /* Context of the timer.                */
+    }isr_timer_t;
+
+    /*******************************************************
+     * ISR TIMER EVENT STRUCTURE
+     *******************************************************/
+    typedef struct {
+        int         type;       /* Timer event type.                */
+        int         id;         /* Id of the timer, 0, 1, ...       */
+        uint16_t    counter;    /* Alarmed counter value.           */
+        void        *context;   /* Context of the timer.            */
+        isr_timer_t *sender;    /* Timer object.                    */
+    }isr_timer_event_t;
+
+
+    /*******************************************************
+     * IsrTimer_Create
+     * Creates and starts an ISR timer.
+     * Returns NULL if all RTL_CONFIG_MAX_ISR_TIMERS are used.
+     * Parameters:
+     * - interval: Alarm interval in ticks (milliseconds).
+     * - callback: Callback function, performed in the tick ISR.
+     * - context: Context of the timer (user data).
+     * - budget_us: Execution budget of the callback (uS),
+     *   up to ISR_TIMER_MAX_BUDGET_US, 0: no budget.
+     *******************************************************/
+    isr_timer_t * IsrTimer_Create(uint16_t interval, callback_t callback, void *context, uint16_t budget_us);
+
+
+    /*******************************************************
+     * IsrTimer_Delete
+     * Stops and deletes the ISR timer.
+     * Parameters:
+     * - timer: ISR timer object.
+     *******************************************************/
+    void IsrTimer_Delete(isr_timer_t * timer);
+
+
+    /*******************************************************
+     * IsrTimer_Start
+     * (Re)starts the ISR timer, the next alarm is the interval
+     * after the call. The overruns are cleared.
+     * Parameters:
+     * - timer: ISR timer object.
+     *******************************************************/
+    void IsrTimer_Start(isr_timer_t * timer);
+
+
+    /*******************************************************
+     * IsrTimer_Stop
+     * Stops the ISR timer.
+     * Parameters:
+     * - timer: ISR timer object.
+     *******************************************************/
+    void IsrTimer_Stop(isr_timer_t * timer);
+
+
+    /*******************************************************
+     * IsrTimer_IsActive
+     * Returns true if the ISR timer is running. A timer that
+     * reaches the RTL_CONFIG_ISR_TIMER_OVERRUN_LIMIT is stopped
+     * by the ISR.
+     * Parameters:
+     * - timer: ISR timer object.
+     *******************************************************/
+    bool IsrTimer_IsActive(isr_timer_t * timer);
+
+
+    /*******************************************************
+     * IsrTimer_IsIdle
+     * Returns true if no ISR timer is running (no tick is
+     * needed by the ISR timers).
+     *******************************************************/
+    bool IsrTimer_IsIdle(void);
+
+
+    /***********************************************************
+     * IsrTimer_TickIsrExecutor (ISR context)
+     * This function is called by the RTL_TickIsrExecutor().
+     ***********************************************************/
+    inline void IsrTimer_TickIsrExecutor(void);
+
+#endif // __RTL_ISR_TIMER_H__
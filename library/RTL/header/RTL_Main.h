@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  17 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __RTL_MAIN_H__
@@ -16,14 +16,47 @@
 
     /*******************************************************
      * RTL_TickIsrExecutor (extern)
-     * Increases the rtl_isr_ticks used in the RTL_Executor().
+     * Increases the rtl_isr_ticks used in the RTL_Executor()
+     * and performs the ISR timers (RTL_IsrTimer).
      * This function must be called by system ticker.
      *******************************************************/
     extern inline void RTL_TickIsrExecutor(void);
 
+    /*******************************************************
+     * RTL_TickIsrAddTicks
+     * Adds the ticks suppressed by the tickless idle, they
+     * are executed by the RTL_Executor() (the timers are
+     * alarmed by their overrun policies).
+     *******************************************************/
+    void RTL_TickIsrAddTicks(uint16_t ticks);
+
+    /*******************************************************
+     * RTL_GetIdleTicks
+     * Returns the number of ticks the RTL can sleep, up to the
+     * earliest timer alarm. It is 0 if the RTL is pending, or
+     * an ISR timer or a thread is running (they need every
+     * tick). It is used by the tickless idle of the RTOS.
+     *******************************************************/
+    uint16_t RTL_GetIdleTicks(void);
+
+    /*******************************************************
+     * RTL_GetPendingTicks
+     * Returns the number of ticks that are not executed yet
+     * by the RTL_Executor() (the backlog of the main loop).
+     *******************************************************/
+    uint16_t RTL_GetPendingTicks(void);
+
+    /*******************************************************
+     * RTL_IsPending
+     * Returns true if a tick, a bus event or a woken thread
+     * is waiting for the RTL_Executor(), the main loop must
+     * not be idle.
+     *******************************************************/
+    bool RTL_IsPending(void);
+
     /*******************************************************
      * RTL_Executor
-     * Performs all executors.
+     * Performs all executors, all pending ticks are executed.
      * This function must be called by the main infinite loop.
      *******************************************************/
     inline void RTL_Executor(void);
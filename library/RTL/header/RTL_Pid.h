@@ -0,0 +1,203 @@
+/************************************************************
+ * File:    RTL_Pid.h                                       *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __RTL_PID_H__
+
+    #define __RTL_PID_H__
+
+    #include <RTL_Config.h>
+    #include <RTL_Fixed.h>
+    #include <BSP_Clock.h>
+
+    /*******************************************************
+     * PID CONTROL LOOP
+     * The loop reads its ADC channel, computes the fixed-point
+     * PID and writes the duty cycle of its PWM channel. The
+     * loops are performed by the Timer2 interrupt (the time
+     * base of the PWM) at RTL_CONFIG_PID_ISR_PRIORITY, every
+     * interval PWM periods. The loop rate is the PWM frequency
+     * divided by the interval (e.g. 2kHz for the 20kHz PWM and
+     * the interval 10), it does not depend on the main loop or
+     * the system tick. The _T2Interrupt is owned by this module.
+     * - Input:  Adc_Get() of the channel, scaled to Q15.
+     * - Output: Q15 duty cycle (0 - Q15_MAX) written to the
+     *           OCxRS register, the PWM must be initialized by
+     *           the Pwm_Init() (PWM_ID_0 - PWM_ID_3 are the
+     *           OC1 - OC4). Do not use the Pwm_SetDuty() on
+     *           the channel of a running loop.
+     * - Anti-windup: The integrator is clamped to the output
+     *           limits and it is held while the output is
+     *           saturated in the direction of the error.
+     * The period and the execution time of every run are
+     * measured by the Timer5 clock (BSP_Clock). They are wall
+     * clock times, only the interrupts above the
+     * RTL_CONFIG_PID_ISR_PRIORITY (e.g. the Timer5 overflow)
+     * can be nested in a run. A run longer than the
+     * RTL_CONFIG_PID_BUDGET_US is counted as an overrun, the
+     * loop is never stopped by the overruns.
+     *******************************************************/
+
+    /*******************************************************
+     * Maximum shift of the gains
+     *******************************************************/
+    #define PID_MAX_SHIFT           15
+
+    /*******************************************************
+     * PID LOOP OBJECT STRUCTURE
+     *******************************************************/
+    typedef struct {
+        int16_t     id;         /* Id of the loop, -1: not initialized. */
+        uint16_t    adc_id;     /* ADC channel of the measurement.      */
+        uint16_t    pwm_id;     /* PWM channel of the output.           */
+        uint16_t    interval;   /* Run interval (PWM periods).          */
+        uint16_t    ticks;      /* PWM periods to the next run.         */
+        q15_t       kp;         /* Proportional gain.                   */
+        q15_t       ki;         /* Integral gain (per run).             */
+        q15_t       kd;         /* Derivative gain (per run).           */
+        uint16_t    shift;      /* Gains are k * 2^shift.               */
+        q15_t       out_min;    /* Lower limit of the output.           */
+        q15_t       out_max;    /* Upper limit of the output.           */
+        q15_t       setpoint;   /* Setpoint of the loop.                */
+        q15_t       pv;         /* Last measurement.                    */
+        q15_t       output;     /* Last output.                         */
+        bool        primed;     /* The pv is valid (derivative).        */
+        q31_t       integ;      /* Integrator (Q30 of the sum).         */
+        uint16_t    stamp;      /* Timer5 stamp of the last run.        */
+        int16_t     jitter;     /* Last period error (Timer5 counts).   */
+        uint16_t    jitter_max; /* Maximum |jitter| (Timer5 counts).    */
+        uint16_t    exec;       /* Last execution time (Timer5 counts). */
+        uint16_t    exec_max;   /* Maximum execution time (counts).     */
+        uint16_t    overruns;   /* Number of exceeded budgets.          */
+        uint32_t    runs;       /* Number of runs.                      */
+    }pid_loop_t;
+
+    /*******************************************************
+     * PID LOOP STATISTICS STRUCTURE
+     *******************************************************/
+    typedef struct {
+        uint32_t    runs;           /* Number of runs.                      */
+        int16_t     jitter_us;      /* Last period error (uS).              */
+        uint16_t    jitter_max_us;  /* Maximum |period error| (uS).         */
+        uint16_t    exec_us;        /* Last execution time (uS).            */
+        uint16_t    exec_max_us;    /* Maximum execution time (uS).         */
+        uint16_t    overruns;       /* Number of exceeded budgets.          */
+    }pid_stats_t;
+
+
+    /*******************************************************
+     * Pid_Init
+     * Initializes the loop and registers it to the Timer2
+     * interrupt. The loop is stopped, its gains are zero and
+     * its output limits are 0 - Q15_MAX.
+     * Returns false if the channels are invalid or all
+     * RTL_CONFIG_PID_LOOPS are used.
+     * Parameters:
+     * - loop: PID loop object.
+     * - adc_id: ADC channel (ADC_ID_0, ..., ADC_ID_3).
+     * - pwm_id: PWM channel (PWM_ID_0, ..., PWM_ID_3).
+     * - interval: Run interval in PWM periods (1 - 65535).
+     *******************************************************/
+    bool Pid_Init(pid_loop_t *loop, uint16_t adc_id, uint16_t pwm_id, uint16_t interval);
+
+
+    /*******************************************************
+     * Pid_SetGains
+     * Sets the gains, the effective gain is k * 2^shift, e.g.
+     * Q15(0.75) with the shift 2 is 3.0. The ki and the kd
+     * are the gains of one run (Ki*T and Kd/T).
+     * Parameters:
+     * - loop: PID loop object.
+     * - kp, ki, kd: Gains (Q15).
+     * - shift: Shift of the gains (0 - PID_MAX_SHIFT).
+     *******************************************************/
+    void Pid_SetGains(pid_loop_t *loop, q15_t kp, q15_t ki, q15_t kd, uint16_t shift);
+
+
+    /*******************************************************
+     * Pid_SetLimits
+     * Sets the limits of the output. The PWM duty cycle is
+     * 0 for the negative outputs.
+     * Parameters:
+     * - loop: PID loop object.
+     * - min: Lower limit (Q15).
+     * - max: Upper limit (Q15).
+     *******************************************************/
+    void Pid_SetLimits(pid_loop_t *loop, q15_t min, q15_t max);
+
+
+    /*******************************************************
+     * Pid_SetSetpoint
+     * Sets the setpoint, the ADC full scale is Q15_MAX.
+     * Parameters:
+     * - loop: PID loop object.
+     * - setpoint: Setpoint of the loop (Q15).
+     *******************************************************/
+    void Pid_SetSetpoint(pid_loop_t *loop, q15_t setpoint);
+
+
+    /*******************************************************
+     * Pid_Start
+     * Clears the integrator and the statistics and starts
+     * the loop, the first run is the interval after the call.
+     * The Timer2 interrupt is enabled, the PWM (Timer2) must
+     * be running.
+     * Parameters:
+     * - loop: PID loop object.
+     *******************************************************/
+    void Pid_Start(pid_loop_t *loop);
+
+
+    /*******************************************************
+     * Pid_Stop
+     * Stops the loop, the PWM keeps its last duty cycle.
+     * Parameters:
+     * - loop: PID loop object.
+     *******************************************************/
+    void Pid_Stop(pid_loop_t *loop);
+
+
+    /*******************************************************
+     * Pid_IsRunning
+     * Returns true if the loop is running.
+     * Parameters:
+     * - loop: PID loop object.
+     *******************************************************/
+    bool Pid_IsRunning(pid_loop_t *loop);
+
+
+    /*******************************************************
+     * Pid_Update
+     * Computes one run of the PID and returns the output.
+     * It is called by the loop, it can be used directly to
+     * control other inputs and outputs (stopped loop only).
+     * Parameters:
+     * - loop: PID loop object.
+     * - pv: Measurement (Q15).
+     *******************************************************/
+    q15_t Pid_Update(pid_loop_t *loop, q15_t pv);
+
+
+    /*******************************************************
+     * Pid_GetStats
+     * Copies the jitter and the execution time statistics.
+     * Parameters:
+     * - loop: PID loop object.
+     * - stats: Destination of the statistics.
+     *******************************************************/
+    void Pid_GetStats(pid_loop_t *loop, pid_stats_t *stats);
+
+
+    /*******************************************************
+     * Pid_ResetStats
+     * Clears the statistics of the loop.
+     * Parameters:
+     * - loop: PID loop object.
+     *******************************************************/
+    void Pid_ResetStats(pid_loop_t *loop);
+
+#endif // __RTL_PID_H__
@@ -0,0 +1,198 @@
+/************************************************************
+ * File:    RTL_Thread.h                                    *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#ifndef __RTL_THREAD_H__
+
+    #define __RTL_THREAD_H__
+
+    #include <RTL_Config.h>
+    #include <RTL_Timer.h>
+    #include <RTL_Bus.h>
+
+    /*******************************************************
+     * PROTOTHREADS (stackless cooperative threads)
+     * A thread is a function that returns at every wait and
+     * resumes at the same line in its next call (the local
+     * continuation is the line number in a switch statement).
+     * The threads share the stack, so the local variables are
+     * NOT kept across a wait, keep them in the context or in
+     * static variables. A switch statement cannot be used
+     * around a PT_xxx macro.
+     * The threads are performed by the RTL_Executor(), every
+     * tick and immediately when an awaited event is received.
+     *
+     * Example:
+     *   PT_THREAD(Task(thread_t *pt)) {
+     *       PT_BEGIN(pt);
+     *       while(1) {
+     *           Beep(50);
+     *           PT_SLEEP(pt, 100);
+     *           Uart1_Printf("ADC: %d\r\n", Adc_Get(0));
+     *           PT_AWAIT_EVENT(pt, BUS_TOPIC_KEY);
+     *       }
+     *       PT_END(pt);
+     *   }
+     *******************************************************/
+
+    /*******************************************************
+     * Thread Status (returned by the thread function)
+     *******************************************************/
+    #define PT_WAITING      0   // Waiting for a condition.
+    #define PT_YIELDED      1   // Yielded to the other threads.
+    #define PT_EXITED       2   // Exited by the PT_EXIT().
+    #define PT_ENDED        3   // Reached the PT_END().
+
+    /*******************************************************
+     * Size of the event copy in words
+     *******************************************************/
+    #define THREAD_EVENT_WORDS  ((BUS_EVENT_SIZE + 1) / 2)
+
+    struct thread_s;
+    typedef char (*thread_fn_t)(struct thread_s *);
+
+    /*******************************************************
+     * THREAD OBJECT STRUCTURE
+     *******************************************************/
+    typedef struct thread_s {
+        uint16_t        lc;         /* Local continuation (line).           */
+        thread_fn_t     function;   /* Thread function.                     */
+        void            *context;   /* Context of the thread (user data).   */
+        uint32_t        deadline;   /* Tick of the PT_SLEEP().              */
+        int16_t         listener;   /* Bus subscription (-1: none).         */
+        uint16_t        topic;      /* Awaited topic.                       */
+        bool            ready;      /* The awaited event is received.       */
+        char            *line;      /* Line buffer of the PT_AWAIT_LINE().  */
+        uint16_t        line_size;  /* Size of the line buffer.             */
+        uint16_t        line_len;   /* Length of the received line.         */
+        uint16_t        event[THREAD_EVENT_WORDS];  /* Copy of the event.   */
+        struct thread_s *next;      /* Next thread (internally used).       */
+    }thread_t;
+
+
+    /*******************************************************
+     * Local continuation and basic operations
+     *******************************************************/
+    #define PT_THREAD(name_args)    char name_args
+
+    #define PT_BEGIN(pt)            { char PT_YIELD_FLAG = 1; (void)PT_YIELD_FLAG; switch( (pt)->lc ) { case 0:
+
+    #define PT_END(pt)              } PT_YIELD_FLAG = 0; (pt)->lc = 0; return PT_ENDED; }
+
+    #define PT_SET(pt)              (pt)->lc = __LINE__; case __LINE__:
+
+    #define PT_WAIT_UNTIL(pt, c)    do { PT_SET(pt); if( !(c) ) { return PT_WAITING; } } while(0)
+
+    #define PT_WAIT_WHILE(pt, c)    PT_WAIT_UNTIL(pt, !(c))
+
+    #define PT_YIELD(pt)            do { PT_YIELD_FLAG = 0; PT_SET(pt); if( PT_YIELD_FLAG == 0 ) { return PT_YIELDED; } } while(0)
+
+    #define PT_EXIT(pt)             do { (pt)->lc = 0; return PT_EXITED; } while(0)
+
+    #define PT_RESTART(pt)          do { (pt)->lc = 0; return PT_WAITING; } while(0)
+
+    /*******************************************************
+     * Await primitives
+     * - PT_SLEEP:       Waits for the given milliseconds.
+     * - PT_AWAIT_EVENT: Waits for an event of the bus topic,
+     *                   PT_EVENT() returns the copy of it.
+     * - PT_AWAIT_LINE:  Waits for a line of the UART topic
+     *                   (BUS_TOPIC_UART1_RX/_UART2_RX, see the
+     *                   Bus_Bridge()), the line is terminated
+     *                   by '\r' or '\n' and stored as a string.
+     *******************************************************/
+    #define PT_SLEEP(pt, ms)        do { (pt)->deadline = Timer_GetTicks() + (ms); PT_WAIT_UNTIL(pt, Thread_IsExpired(pt)); } while(0)
+
+    #define PT_AWAIT_EVENT(pt, topic)   do { Thread_Listen(pt, topic, NULL, 0); PT_WAIT_UNTIL(pt, Thread_IsReady(pt)); } while(0)
+
+    #define PT_AWAIT_LINE(pt, topic, buffer, size)  do { Thread_Listen(pt, topic, buffer, size); PT_WAIT_UNTIL(pt, Thread_IsReady(pt)); } while(0)
+
+    #define PT_EVENT(pt, type)      ((type *)(pt)->event)
+
+
+    /*******************************************************
+     * Thread_Create
+     * Starts the thread in the given storage. The storage
+     * must be kept until the thread is ended or killed.
+     * A running thread is restarted from its beginning.
+     * Parameters:
+     * - thread: Storage of the thread.
+     * - function: Thread function.
+     * - context: Context of the thread (user data).
+     *******************************************************/
+    void Thread_Create(thread_t *thread, thread_fn_t function, void *context);
+
+
+    /*******************************************************
+     * Thread_Kill
+     * Stops the thread, its subscription is removed. A thread
+     * killed by a thread is unlinked by the executor, its
+     * storage must be kept until the end of the executor.
+     * Parameters:
+     * - thread: Thread object.
+     *******************************************************/
+    void Thread_Kill(thread_t *thread);
+
+
+    /*******************************************************
+     * Thread_IsAlive
+     * Returns true if the thread is running.
+     * Parameters:
+     * - thread: Thread object.
+     *******************************************************/
+    bool Thread_IsAlive(thread_t *thread);
+
+
+    /*******************************************************
+     * Thread_Listen (used by the PT_AWAIT_xxx)
+     * Subscribes the thread to the topic and clears the
+     * received event (and the line).
+     * Returns false if no subscription is available, the
+     * thread then waits forever.
+     *******************************************************/
+    bool Thread_Listen(thread_t *thread, uint16_t topic, char *line, uint16_t size);
+
+
+    /*******************************************************
+     * Thread_IsReady (used by the PT_AWAIT_xxx)
+     * Returns true if the awaited event (or line) is received,
+     * the subscription is removed then.
+     *******************************************************/
+    bool Thread_IsReady(thread_t *thread);
+
+
+    /*******************************************************
+     * Thread_IsExpired (used by the PT_SLEEP)
+     * Returns true if the deadline of the thread is reached.
+     *******************************************************/
+    bool Thread_IsExpired(thread_t *thread);
+
+
+    /*******************************************************
+     * Thread_IsPending
+     * Returns true if a thread is woken by an event.
+     *******************************************************/
+    bool Thread_IsPending(void);
+
+
+    /*******************************************************
+     * Thread_IsIdle
+     * Returns true if no thread is running. The conditions of
+     * the running threads are polled every tick.
+     *******************************************************/
+    bool Thread_IsIdle(void);
+
+
+    /***********************************************************
+     * Thread_Executor
+     * Performs all threads if a tick is executed, otherwise
+     * only the threads woken by their events.
+     * This function is called by the RTL_Executor().
+     ***********************************************************/
+    inline void Thread_Executor(bool ticked);
+
+#endif // __RTL_THREAD_H__
@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  17 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __RTL_TIMER_H__
@@ -13,16 +13,66 @@
     #include <RTL_Config.h>
 
 
+    /*******************************************************
+     * TIMING WHEEL
+     * The timers are kept in a hierarchical timing wheel of
+     * TIMER_WHEEL_LEVELS levels of (1 << TIMER_WHEEL_BITS)
+     * slots. A slot of the level n covers (1 << (n*BITS))
+     * ticks. Each tick only takes the timers of one slot of
+     * the level 0, the higher levels are cascaded down when
+     * the lower level wraps. The create and delete are O(1),
+     * the cost of a tick does not depend on the number of
+     * timers.
+     *******************************************************/
+    #define TIMER_WHEEL_BITS    4
+    #define TIMER_WHEEL_LEVELS  4
+    #define TIMER_WHEEL_SLOTS   (1 << TIMER_WHEEL_BITS)
+
+    /*******************************************************
+     * Timer Modes
+     *******************************************************/
+    #define TIMER_MODE_PERIODIC     0   /* Alarmed every interval.              */
+    #define TIMER_MODE_ONESHOT      1   /* Alarmed once, then it is stopped.    */
+
+    /*******************************************************
+     * Overrun Policies
+     * Used when a periodic alarm is executed one interval or
+     * more after its deadline (the main loop is stalled).
+     * - CATCHUP:  Every missed alarm is performed (in a burst).
+     * - SKIP:     The missed alarms are dropped, the counter
+     *             only counts the performed alarms.
+     * - COALESCE: The missed alarms are merged into one alarm,
+     *             the counter includes the missed alarms.
+     * The next deadlines keep the phase of the timer.
+     *******************************************************/
+    #define TIMER_OVERRUN_CATCHUP   0
+    #define TIMER_OVERRUN_SKIP      1
+    #define TIMER_OVERRUN_COALESCE  2
+
+    /*******************************************************
+     * Maximum interval (ticks). The deadlines are compared
+     * in the signed 32-bit arithmetic.
+     *******************************************************/
+    #define TIMER_MAX_INTERVAL      0x7FFFFFFFUL
+
     /*******************************************************
      * TIMER OBJECT STRUCTURE
      *******************************************************/
-    typedef struct {
+    typedef struct timer_s {
         int         id;         /* Id of the timer, 0, 1, ...       */
-        uint16_t    interval;   /* Sleep interval in milliseconds.  */
-        uint16_t    ticks;      /* Tick counter (internally used).  */
+        uint32_t    interval;   /* Sleep interval in milliseconds.  */
+        uint8_t     mode;       /* Timer mode, TIMER_MODE_XXX.      */
+        uint8_t     active;     /* The timer is running.            */
         uint16_t    counter;    /* Alarmed counter value.           */
         callback_t  callback;   /* Callback function.               */
         void        *context;   /* Context of the timer.            */
+        uint8_t     policy;     /* Overrun policy, TIMER_OVERRUN_XXX.   */
+        uint16_t    overruns;   /* Total missed alarms (saturated).     */
+        uint16_t    late_max;   /* Maximum lateness in ticks.           */
+
+        uint32_t        expires;    /* Tick of the next alarm (internally used).    */
+        struct timer_s  *next;      /* Next timer of the slot (internally used).    */
+        struct timer_s  **pprev;    /* Link to this timer (internally used).        */
     }timer_t;
 
     #define EVT_TIMER_ALARM 0
@@ -36,28 +86,185 @@
         uint16_t    counter;    /* Alarmed counter value.           */
         void        *context;   /* Context of the timer.            */
         timer_t     *sender;    /* Timer object,                    */
+        uint16_t    missed;     /* Alarms dropped/merged before this one.   */
+        uint16_t    late;       /* Ticks from the deadline to the alarm.    */
     }timer_event_t;
 
 
     /*******************************************************
      * Timer_Create
      * Creates and returns a timer object.
+     * Returns NULL if all RTL_CONFIG_MAX_TIMERS are used.
+     * Parameters:
+     * - interval: Sleeping interval in milliseconds.
+     * - callback: Callback function, performed when the timer ready.
+     *******************************************************/
+    timer_t * Timer_Create(uint32_t interval, callback_t callback);
+
+
+    /*******************************************************
+     * Timer_CreateOneShot
+     * Creates and starts a one-shot timer. The timer is
+     * stopped after its alarm, it is not deleted, it can be
+     * started again by the Timer_Start() or Timer_Reset().
+     * Returns NULL if all RTL_CONFIG_MAX_TIMERS are used.
+     * Parameters:
+     * - interval: Delay of the alarm in milliseconds.
+     * - callback: Callback function, performed when the timer ready.
+     *******************************************************/
+    timer_t * Timer_CreateOneShot(uint32_t interval, callback_t callback);
+
+
+    /*******************************************************
+     * Timer_CreateWithContext
+     * Same as the Timer_Create(), the context is passed to
+     * the callback function in the timer event.
+     * Parameters:
+     * - interval: Sleeping interval in milliseconds.
+     * - callback: Callback function, performed when the timer ready.
+     * - context: Context of the timer (user data).
+     *******************************************************/
+    timer_t * Timer_CreateWithContext(uint32_t interval, callback_t callback, void *context);
+
+
+    /*******************************************************
+     * Timer_CreateStatic
+     * Creates and starts a periodic timer in the given storage,
+     * it is not taken from the pool of RTL_CONFIG_MAX_TIMERS.
+     * The storage must be kept until the timer is deleted.
+     * The ids of the static timers follow the ids of the pool.
+     * Returns the timer, or NULL if a parameter is NULL.
      * Parameters:
+     * - timer: Storage of the timer (not running).
      * - interval: Sleeping interval in milliseconds.
      * - callback: Callback function, performed when the timer ready.
+     * - context: Context of the timer (user data).
+     *******************************************************/
+    timer_t * Timer_CreateStatic(timer_t *timer, uint32_t interval, callback_t callback, void *context);
+
+
+    /*******************************************************
+     * Timer_SetMode
+     * Sets the mode of the timer, it is used from the next alarm.
+     * Parameters:
+     * - timer: timer object.
+     * - mode: TIMER_MODE_PERIODIC or TIMER_MODE_ONESHOT.
+     *******************************************************/
+    void Timer_SetMode(timer_t * timer, uint8_t mode);
+
+
+    /*******************************************************
+     * Timer_SetOverrunPolicy
+     * Sets the overrun policy of the periodic timer.
+     * The default policy is TIMER_OVERRUN_CATCHUP.
+     * Parameters:
+     * - timer: timer object.
+     * - policy: TIMER_OVERRUN_CATCHUP, _SKIP or _COALESCE.
      *******************************************************/
-    timer_t * Timer_Create(uint16_t interval, callback_t callback);
+    void Timer_SetOverrunPolicy(timer_t * timer, uint8_t policy);
+
+
+    /*******************************************************
+     * Timer_ResetOverruns
+     * Clears the overruns and late_max statistics of the timer.
+     * Parameters:
+     * - timer: timer object.
+     *******************************************************/
+    void Timer_ResetOverruns(timer_t * timer);
 
 
     /*******************************************************
      * Timer_Delete
-     * Deletes the given timer object.
+     * Deletes the given timer object. An alarm already posted
+     * to the dispatcher is still delivered, its sender must
+     * not be used after the delete.
      * Parameters:
      * - timer: timer object to be removed.
      *******************************************************/
     void Timer_Delete(timer_t * timer);
 
 
+    /*******************************************************
+     * Timer_Start
+     * Starts the stopped timer, the first alarm is the
+     * interval after the call. A running timer is not changed.
+     * Parameters:
+     * - timer: timer object.
+     *******************************************************/
+    void Timer_Start(timer_t * timer);
+
+
+    /*******************************************************
+     * Timer_StartAt
+     * Starts (or restarts) the timer with its first alarm at
+     * the given absolute tick (see the Timer_GetTicks()).
+     * A deadline in the past is alarmed at the next tick.
+     * The next alarms of a periodic timer are computed from
+     * the deadline, they do not drift.
+     * Parameters:
+     * - timer: timer object.
+     * - deadline: Tick of the first alarm.
+     *******************************************************/
+    void Timer_StartAt(timer_t * timer, uint32_t deadline);
+
+
+    /*******************************************************
+     * Timer_Stop
+     * Stops the timer, the timer object is kept.
+     * Parameters:
+     * - timer: timer object.
+     *******************************************************/
+    void Timer_Stop(timer_t * timer);
+
+
+    /*******************************************************
+     * Timer_Reset
+     * Restarts the timer, the next alarm is the interval
+     * after the call. A stopped timer is started.
+     * Parameters:
+     * - timer: timer object.
+     *******************************************************/
+    void Timer_Reset(timer_t * timer);
+
+
+    /*******************************************************
+     * Timer_ChangePeriod
+     * Changes the interval of the timer and restarts it,
+     * the next alarm is the new interval after the call.
+     * A stopped timer is started.
+     * Parameters:
+     * - timer: timer object.
+     * - interval: New interval in milliseconds.
+     *******************************************************/
+    void Timer_ChangePeriod(timer_t * timer, uint32_t interval);
+
+
+    /*******************************************************
+     * Timer_IsActive
+     * Returns true if the timer is running.
+     * Parameters:
+     * - timer: timer object.
+     *******************************************************/
+    bool Timer_IsActive(timer_t * timer);
+
+
+    /*******************************************************
+     * Timer_GetTicks
+     * Returns the current tick of the timers (free-running,
+     * used as the base of the absolute deadlines).
+     *******************************************************/
+    uint32_t Timer_GetTicks(void);
+
+
+    /*******************************************************
+     * Timer_GetIdleTicks
+     * Returns the number of ticks before the earliest alarm of
+     * the running timers (0xFFFF if no timer is running).
+     * It is used by the tickless idle (RTL_GetIdleTicks).
+     *******************************************************/
+    uint16_t Timer_GetIdleTicks(void);
+
+
     /***********************************************************
      * Timer_TickedExecutor (ticked execution)
      * This function is called by the RTL_Executor() every tick.
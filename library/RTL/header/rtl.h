@@ -3,7 +3,7 @@
  * Author:  Asst.Prof.Dr.Santi Nuratch                      *
  *          Embedded Computing and Control Laboratory       *
  *          ECC-Lab, INC, KMUTT, Thailand                   *
- * Update:  18 February 2020                                *
+ * Update:  19 October 2026                                 *
  ************************************************************/
 
 #ifndef __RTL_H__
@@ -13,5 +13,11 @@
     #include <RTL_Config.h>
     #include <RTL_Main.h>
     #include <RTL_Timer.h>
+    #include <RTL_IsrTimer.h>
+    #include <RTL_Bus.h>
+    #include <RTL_Thread.h>
+    #include <RTL_Hsm.h>
+    #include <RTL_Fixed.h>
+    #include <RTL_Pid.h>
 
 #endif // __RTL_H__
@@ -0,0 +1,263 @@
+/************************************************************
+ * File:    RTL_Bus.c                                       *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_Bus.h>
+#include <bsp.h>
+
+#if RTL_CONFIG_BUS_TOPICS > 255 || RTL_CONFIG_BUS_SUBSCRIBERS > 255
+    #error "RTL_CONFIG_BUS_TOPICS and RTL_CONFIG_BUS_SUBSCRIBERS must not be greater than 255"
+#endif
+
+/*******************************************************
+ * Size of the event copy in words (the events contain
+ * word data, they must be word aligned)
+ *******************************************************/
+#define BUS_EVENT_WORDS     ((BUS_EVENT_SIZE + 1) / 2)
+
+/*******************************************************
+ * End of a list of the subscribers
+ *******************************************************/
+#define BUS_NONE            0xFF
+
+/*******************************************************
+ * SUBSCRIBER STRUCTURE
+ *******************************************************/
+typedef struct {
+    callback_t  callback;               // Callback function (NULL: free).
+    void        *context;               // Context of the subscriber.
+    uint8_t     topic;                  // Topic of the subscription.
+    uint8_t     next;                   // Next subscriber of the topic.
+}bus_subscriber_t;
+
+/*******************************************************
+ * RING ENTRY STRUCTURE
+ *******************************************************/
+typedef struct {
+    uint8_t     topic;                  // Topic of the event.
+    uint8_t     size;                   // Size of the data (bytes).
+    uint16_t    data[BUS_EVENT_WORDS];  // Copy of the data (word aligned).
+}bus_entry_t;
+
+/*******************************************************
+ * Bus objects
+ * - __subscribers: Subscriptions, linked into one list
+ *                  per topic.
+ * - __heads:       First subscriber of the topics.
+ * - __ring:        Event ring, __count events from __first.
+ *******************************************************/
+static bus_subscriber_t     __subscribers[RTL_CONFIG_BUS_SUBSCRIBERS];
+static uint8_t              __heads[RTL_CONFIG_BUS_TOPICS];
+static bool                 __initialized = false;
+static bus_entry_t          __ring[RTL_CONFIG_BUS_QUEUE_LENGTH];
+static uint8_t              __first;
+static volatile uint8_t     __count;
+static uint16_t             __dropped;
+
+
+/************************************************************
+ * __bus_init
+ * Clears the lists of the topics.
+ ************************************************************/
+static void __bus_init(void) {
+    memset(__heads, BUS_NONE, sizeof(__heads));
+    __initialized = true;
+}
+
+
+/************************************************************
+ * Bus_Subscribe
+ ************************************************************/
+int16_t Bus_Subscribe(uint16_t topic, callback_t callback, void *context) {
+
+    bus_subscriber_t *sub;
+    uint8_t          *link;
+    uint8_t           i;
+
+    if( !__initialized ) {
+        __bus_init();
+    }
+
+    if( topic >= RTL_CONFIG_BUS_TOPICS || callback == NULL ) {
+        return -1;
+    }
+
+    for( i = 0; i < RTL_CONFIG_BUS_SUBSCRIBERS; i++ ) {
+        sub = &__subscribers[i];
+        if( sub->callback == NULL ) {
+            sub->callback = callback;
+            sub->context  = context;
+            sub->topic    = topic;
+            sub->next     = BUS_NONE;
+
+            // Appended, the subscribers are called in the subscribing order.
+            link = &__heads[topic];
+            while( *link != BUS_NONE ) {
+                link = &__subscribers[*link].next;
+            }
+            *link = i;
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+/************************************************************
+ * Bus_Unsubscribe
+ ************************************************************/
+void Bus_Unsubscribe(int16_t handle) {
+
+    bus_subscriber_t *sub;
+    uint8_t          *link;
+
+    if( handle < 0 || handle >= RTL_CONFIG_BUS_SUBSCRIBERS ) {
+        return;
+    }
+
+    sub = &__subscribers[handle];
+    if( sub->callback == NULL ) {
+        return;
+    }
+
+    link = &__heads[sub->topic];
+    while( *link != BUS_NONE && *link != handle ) {
+        link = &__subscribers[*link].next;
+    }
+    if( *link == handle ) {
+        *link = sub->next;
+    }
+    sub->callback = NULL;
+    sub->context  = NULL;
+}
+
+
+/************************************************************
+ * Bus_Publish
+ ************************************************************/
+bool Bus_Publish(uint16_t topic, const void *data, uint16_t size) {
+
+    bus_entry_t *entry;
+    bool         queued = false;
+
+    if( topic >= RTL_CONFIG_BUS_TOPICS || !__initialized || __heads[topic] == BUS_NONE ) {
+        return true;    // No subscriber, nothing to deliver.
+    }
+
+    if( size <= BUS_EVENT_SIZE ) {
+        PERFORM_CRITICAL_SECTION( {
+            if( __count < RTL_CONFIG_BUS_QUEUE_LENGTH ) {
+                entry = &__ring[(__first + __count) % RTL_CONFIG_BUS_QUEUE_LENGTH];
+                entry->topic = topic;
+                entry->size  = size;
+                memcpy(entry->data, data, size);
+                __count++;
+                queued = true;
+            }
+        } );
+    }
+
+    if( !queued ) {
+        __dropped++;
+    }
+    return queued;
+}
+
+
+/************************************************************
+ * Bus_IsPending
+ ************************************************************/
+bool Bus_IsPending(void) {
+    return __count > 0;
+}
+
+
+/************************************************************
+ * Bus_GetDropped
+ ************************************************************/
+uint16_t Bus_GetDropped(void) {
+    return __dropped;
+}
+
+
+/************************************************************
+ * Bus_Executor
+ * The entry stays in the ring while it is delivered, it is
+ * not overwritten by the events published by the subscribers.
+ ************************************************************/
+inline void Bus_Executor(void) {
+
+    bus_entry_t      *entry;
+    bus_subscriber_t *sub;
+    bus_event_t       evt;
+    uint8_t           batch, idx;
+
+    batch = __count;
+    while( batch-- > 0 ) {
+        entry     = &__ring[__first];
+        evt.topic = entry->topic;
+        evt.size  = entry->size;
+        evt.data  = entry->data;
+
+        idx = __heads[entry->topic];
+        while( idx != BUS_NONE ) {
+            sub         = &__subscribers[idx];
+            evt.context = sub->context;
+            sub->callback(&evt);
+            idx         = sub->next;    // Read after the callback, it may unsubscribe any subscriber.
+        }
+
+        PERFORM_CRITICAL_SECTION( {
+            __first = (__first + 1) % RTL_CONFIG_BUS_QUEUE_LENGTH;
+            __count--;
+        } );
+    }
+}
+
+
+/************************************************************
+ * Relays of the BSP callbacks
+ ************************************************************/
+static void __bus_relay_key(void *evt) {
+    Bus_Publish(BUS_TOPIC_KEY, evt, sizeof(switch_event_t));
+}
+
+static void __bus_relay_adc(void *evt) {
+    Bus_Publish(BUS_TOPIC_ADC, evt, sizeof(adc_event_t));
+}
+
+static void __bus_relay_uart1(void *evt) {
+    Bus_Publish(BUS_TOPIC_UART1_RX, evt, sizeof(uart_event_t));
+}
+
+static void __bus_relay_uart2(void *evt) {
+    Bus_Publish(BUS_TOPIC_UART2_RX, evt, sizeof(uart_event_t));
+}
+
+static void __bus_relay_beep(void *evt) {
+    Bus_Publish(BUS_TOPIC_BEEP, evt, sizeof(beep_event_t));
+}
+
+static void __bus_relay_led(void *evt) {
+    Bus_Publish(BUS_TOPIC_LED, evt, sizeof(led_event_t));
+}
+
+
+/************************************************************
+ * Bus_Bridge
+ ************************************************************/
+bool Bus_Bridge(uint16_t topic, int16_t id) {
+    switch( topic ) {
+        case BUS_TOPIC_KEY:         return Psw_SetKeyChangedCallback(id, __bus_relay_key);
+        case BUS_TOPIC_ADC:         Adc_SetChangedCallback(id, __bus_relay_adc);        return true;
+        case BUS_TOPIC_UART1_RX:    Uart1_SetRxCallback(__bus_relay_uart1);             return true;
+        case BUS_TOPIC_UART2_RX:    Uart2_SetRxCallback(__bus_relay_uart2);             return true;
+        case BUS_TOPIC_BEEP:        Beep_SetCallback(__bus_relay_beep);                 return true;
+        case BUS_TOPIC_LED:         Led_SetChangedCallback(id, __bus_relay_led);        return true;
+    }
+    return false;
+}
@@ -0,0 +1,318 @@
+/************************************************************
+ * File:    RTL_Fixed.c                                     *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_Fixed.h>
+
+/*******************************************************
+ * Quarter-wave sine table, sin(i*90/256 degrees) in Q15
+ *******************************************************/
+static const q15_t __sin_table[257] = {
+        0,   201,   402,   603,   804,  1005,  1206,  1407,
+     1608,  1809,  2009,  2210,  2411,  2611,  2811,  3012,
+     3212,  3412,  3612,  3812,  4011,  4211,  4410,  4609,
+     4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,
+     6393,  6590,  6787,  6983,  7180,  7376,  7571,  7767,
+     7962,  8157,  8351,  8546,  8740,  8933,  9127,  9319,
+     9512,  9704,  9896, 10088, 10279, 10469, 10660, 10850,
+    11039, 11228, 11417, 11605, 11793, 11980, 12167, 12354,
+    12540, 12725, 12910, 13095, 13279, 13463, 13646, 13828,
+    14010, 14192, 14373, 14553, 14733, 14912, 15091, 15269,
+    15447, 15624, 15800, 15976, 16151, 16326, 16500, 16673,
+    16846, 17018, 17190, 17361, 17531, 17700, 17869, 18037,
+    18205, 18372, 18538, 18703, 18868, 19032, 19195, 19358,
+    19520, 19681, 19841, 20001, 20160, 20318, 20475, 20632,
+    20788, 20943, 21097, 21251, 21403, 21555, 21706, 21856,
+    22006, 22154, 22302, 22449, 22595, 22740, 22884, 23028,
+    23170, 23312, 23453, 23593, 23732, 23870, 24008, 24144,
+    24279, 24414, 24548, 24680, 24812, 24943, 25073, 25202,
+    25330, 25457, 25583, 25708, 25833, 25956, 26078, 26199,
+    26320, 26439, 26557, 26674, 26791, 26906, 27020, 27133,
+    27246, 27357, 27467, 27576, 27684, 27791, 27897, 28002,
+    28106, 28209, 28311, 28411, 28511, 28610, 28707, 28803,
+    28899, 28993, 29086, 29178, 29269, 29359, 29448, 29535,
+    29622, 29707, 29792, 29875, 29957, 30038, 30118, 30196,
+    30274, 30350, 30425, 30499, 30572, 30644, 30715, 30784,
+    30853, 30920, 30986, 31050, 31114, 31177, 31238, 31298,
+    31357, 31415, 31471, 31527, 31581, 31634, 31686, 31737,
+    31786, 31834, 31881, 31927, 31972, 32015, 32058, 32099,
+    32138, 32177, 32214, 32251, 32286, 32319, 32352, 32383,
+    32413, 32442, 32470, 32496, 32522, 32546, 32568, 32590,
+    32610, 32629, 32647, 32664, 32679, 32693, 32706, 32718,
+    32729, 32738, 32746, 32753, 32758, 32762, 32766, 32767,
+    32767,
+};
+
+
+/************************************************************
+ * Q15_Sat
+ ************************************************************/
+q15_t Q15_Sat(int32_t x) {
+    if( x > Q15_MAX ) {
+        return Q15_MAX;
+    }
+    if( x < Q15_MIN ) {
+        return Q15_MIN;
+    }
+    return (q15_t)x;
+}
+
+
+/************************************************************
+ * Q15_Add, Q15_Sub
+ ************************************************************/
+q15_t Q15_Add(q15_t a, q15_t b) {
+    return Q15_Sat((int32_t)a + b);
+}
+
+q15_t Q15_Sub(q15_t a, q15_t b) {
+    return Q15_Sat((int32_t)a - b);
+}
+
+
+/************************************************************
+ * Q15_Mul
+ * Only -1.0 * -1.0 overflows.
+ ************************************************************/
+q15_t Q15_Mul(q15_t a, q15_t b) {
+    return Q15_Sat((int32_t)__builtin_mulss(a, b) >> 15);
+}
+
+
+/************************************************************
+ * Q15_Div
+ ************************************************************/
+q15_t Q15_Div(q15_t a, q15_t b) {
+    int32_t n = (int32_t)a << 15;
+    if( b == 0 ) {
+        return (a >= 0) ? Q15_MAX : Q15_MIN;
+    }
+    // The quotient of the 32/16 division must fit 16 bits.
+    if( (a >= 0) == (b > 0) ) {
+        if( (a >= 0 ? (int32_t)a : -(int32_t)a) >= (b > 0 ? (int32_t)b : -(int32_t)b) ) {
+            return Q15_MAX;
+        }
+    }
+    else if( (a >= 0 ? (int32_t)a : -(int32_t)a) > (b > 0 ? (int32_t)b : -(int32_t)b) ) {
+        return Q15_MIN;
+    }
+    return (q15_t)__builtin_divsd(n, b);
+}
+
+
+/************************************************************
+ * Q31_Add, Q31_Sub
+ ************************************************************/
+q31_t Q31_Add(q31_t a, q31_t b) {
+    q31_t r = (q31_t)((uint32_t)a + (uint32_t)b);
+    if( ((a ^ r) & (b ^ r)) < 0 ) {
+        return (a < 0) ? Q31_MIN : Q31_MAX;
+    }
+    return r;
+}
+
+q31_t Q31_Sub(q31_t a, q31_t b) {
+    q31_t r = (q31_t)((uint32_t)a - (uint32_t)b);
+    if( ((a ^ b) & (a ^ r)) < 0 ) {
+        return (a < 0) ? Q31_MIN : Q31_MAX;
+    }
+    return r;
+}
+
+
+/************************************************************
+ * Q31_Mul
+ * a*b = ah*bh*2^32 + (ah*bl + al*bh)*2^16 + al*bl, the
+ * result is (a*b) >> 31.
+ ************************************************************/
+q31_t Q31_Mul(q31_t a, q31_t b) {
+
+    int16_t  ah = (int16_t)(a >> 16), bh = (int16_t)(b >> 16);
+    uint16_t al = (uint16_t)a,        bl = (uint16_t)b;
+    int32_t  hh, mid;
+
+    if( a == Q31_MIN && b == Q31_MIN ) {
+        return Q31_MAX;
+    }
+
+    hh  = (int32_t)__builtin_mulss(ah, bh);
+    mid = ((int32_t)__builtin_mulsu(ah, bl) >> 1) + ((int32_t)__builtin_mulsu(bh, al) >> 1);
+    // The shift and the sum wrap in the unsigned arithmetic (ah = bh = -32768).
+    return (q31_t)(((uint32_t)hh << 1) + (uint32_t)(mid >> 14));
+}
+
+
+/************************************************************
+ * Q31_MulQ15
+ ************************************************************/
+q31_t Q31_MulQ15(q31_t a, q15_t b) {
+
+    int16_t  ah = (int16_t)(a >> 16);
+    uint16_t al = (uint16_t)a;
+
+    if( a == Q31_MIN && b == Q15_MIN ) {
+        return Q31_MAX;
+    }
+    return (q31_t)(((uint32_t)__builtin_mulss(ah, b) << 1) + (uint32_t)((int32_t)__builtin_mulsu(b, al) >> 15));
+}
+
+
+/************************************************************
+ * Q15_Sin
+ ************************************************************/
+q15_t Q15_Sin(uint16_t angle) {
+
+    uint16_t quadrant = angle >> 14;
+    uint16_t index    = angle & 0x3FFF;
+    uint16_t i, frac;
+    int16_t  v;
+
+    // The 2nd and the 4th quadrants are mirrored.
+    if( quadrant & 1 ) {
+        index = 0x4000 - index;
+    }
+
+    i    = index >> 6;
+    frac = index & 0x3F;
+    v    = __sin_table[i];
+    if( frac != 0 ) {
+        v += (int16_t)(__builtin_mulss(__sin_table[i + 1] - v, frac) >> 6);
+    }
+    return (quadrant & 2) ? -v : v;
+}
+
+
+/************************************************************
+ * Q15_Cos
+ ************************************************************/
+q15_t Q15_Cos(uint16_t angle) {
+    return Q15_Sin(angle + FIXED_ANGLE_90);
+}
+
+
+/************************************************************
+ * Fixed_Sqrt32
+ * Bitwise square root (one result bit per iteration).
+ ************************************************************/
+uint16_t Fixed_Sqrt32(uint32_t x) {
+
+    uint32_t root = 0;
+    uint32_t bit  = 1UL << 30;
+
+    while( bit > x ) {
+        bit >>= 2;
+    }
+    while( bit != 0 ) {
+        if( x >= root + bit ) {
+            x   -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
+
+
+/************************************************************
+ * Q15_Sqrt
+ ************************************************************/
+q15_t Q15_Sqrt(q15_t x) {
+    if( x <= 0 ) {
+        return 0;
+    }
+    return (q15_t)Fixed_Sqrt32((uint32_t)x << 15);
+}
+
+
+/************************************************************
+ * __fixed_atan
+ * atan(z) for z = 0 - 1.0 (Q15), in the angle units:
+ * atan(z) = pi/4*z + 0.273*z*(1-z) (radians).
+ ************************************************************/
+static uint16_t __fixed_atan(uint16_t z) {
+    uint32_t zz = __builtin_muluu(z, 0x8000u - z) >> 15;
+    return (uint16_t)((__builtin_muluu(z, 8192) >> 15) + (__builtin_muluu((uint16_t)zz, 2847) >> 15));
+}
+
+
+/************************************************************
+ * Fixed_Atan2
+ * The vector is reduced to the first octant.
+ ************************************************************/
+uint16_t Fixed_Atan2(int16_t y, int16_t x) {
+
+    uint16_t ax = (x < 0) ? -(int32_t)x : x;
+    uint16_t ay = (y < 0) ? -(int32_t)y : y;
+    uint16_t angle;
+
+    if( ax == 0 && ay == 0 ) {
+        return 0;
+    }
+
+    if( ay <= ax ) {
+        angle = __fixed_atan(__builtin_divud((uint32_t)ay << 15, ax));
+    }
+    else {
+        angle = FIXED_ANGLE_90 - __fixed_atan(__builtin_divud((uint32_t)ax << 15, ay));
+    }
+
+    if( x < 0 ) {
+        angle = FIXED_ANGLE_180 - angle;
+    }
+    if( y < 0 ) {
+        angle = -angle;
+    }
+    return angle;
+}
+
+
+#if RTL_CONFIG_FIXED_BENCHMARK > 0
+
+#include <bsp.h>
+#include <math.h>
+
+/*******************************************************
+ * Operands of the benchmark, volatile to keep the work
+ *******************************************************/
+static volatile q15_t   __qa = Q15(0.7), __qb = Q15(-0.3), __qr;
+static volatile float   __fa = 0.7f,     __fb = -0.3f,     __fr;
+static volatile uint16_t __angle = FIXED_ANGLE_DEG(30);
+
+/*******************************************************
+ * Cycles of the statement (Timer5 counts, 1:1 prescaler)
+ *******************************************************/
+#define FIXED_BENCH(name, stmt) {                                   \
+    uint16_t __begin = CLOCK_STAMP_COUNTS();                        \
+    stmt;                                                           \
+    Uart1_Printf("%-10s %5u\r\n", name,                             \
+        (uint16_t)(CLOCK_STAMP_COUNTS() - __begin) * CLOCK_PRESCALE); \
+}
+
+
+/************************************************************
+ * Fixed_Benchmark
+ ************************************************************/
+void Fixed_Benchmark(void) {
+    Uart1_Printf("Cycles (fixed vs float)\r\n");
+    FIXED_BENCH("Q15_Mul",  __qr = Q15_Mul(__qa, __qb));
+    FIXED_BENCH("f_mul",    __fr = __fa * __fb);
+    FIXED_BENCH("Q15_Add",  __qr = Q15_Add(__qa, __qb));
+    FIXED_BENCH("f_add",    __fr = __fa + __fb);
+    FIXED_BENCH("Q15_Div",  __qr = Q15_Div(__qb, __qa));
+    FIXED_BENCH("f_div",    __fr = __fb / __fa);
+    FIXED_BENCH("Q15_Sin",  __qr = Q15_Sin(__angle));
+    FIXED_BENCH("sinf",     __fr = sinf(__fa));
+    FIXED_BENCH("Q15_Sqrt", __qr = Q15_Sqrt(__qa));
+    FIXED_BENCH("sqrtf",    __fr = sqrtf(__fa));
+    FIXED_BENCH("Atan2",    __qr = Fixed_Atan2(__qb, __qa));
+    FIXED_BENCH("atan2f",   __fr = atan2f(__fb, __fa));
+}
+
+#endif // RTL_CONFIG_FIXED_BENCHMARK
@@ -0,0 +1,376 @@
+/************************************************************
+ * File:    RTL_Hsm.c                                       *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_Hsm.h>
+
+/*******************************************************
+ * EVENT SOURCE BINDING STRUCTURE
+ *******************************************************/
+typedef struct {
+    hsm_t       *sm;        // Target machine (NULL: free).
+    uint8_t     event;      // Event id dispatched to the machine.
+    uint16_t    topic;      // Bus topic (topic binding).
+    int16_t     handle;     // Bus subscription, -1: timer binding.
+    timer_t     *timer;     // Timer (timer binding).
+}hsm_binding_t;
+
+/*******************************************************
+ * Bindings of the bus topics and the timers
+ *******************************************************/
+static hsm_binding_t __bindings[RTL_CONFIG_HSM_BINDINGS];
+
+
+/************************************************************
+ * __hsm_parent
+ * Returns the parent of the state.
+ ************************************************************/
+static inline uint8_t __hsm_parent(hsm_t *sm, uint8_t state) {
+    return sm->def->states[state].parent;
+}
+
+
+/************************************************************
+ * __hsm_depth
+ * Returns the depth of the state (1: top level state), or
+ * 0 if it is deeper than HSM_MAX_DEPTH or its parents are
+ * invalid (e.g. a cycle).
+ ************************************************************/
+static uint16_t __hsm_depth(const hsm_def_t *def, uint8_t state) {
+    uint16_t depth;
+    for( depth = 1; depth <= HSM_MAX_DEPTH; depth++ ) {
+        if( state >= def->state_count ) {
+            return 0;
+        }
+        state = def->states[state].parent;
+        if( state == HSM_NONE ) {
+            return depth;
+        }
+    }
+    return 0;
+}
+
+
+/************************************************************
+ * __hsm_enter
+ * Enters the states from below the top state down to the
+ * target, then the initial sub-states of the target.
+ * The current state is updated. The tables are checked
+ * by the Hsm_Init().
+ ************************************************************/
+static void __hsm_enter(hsm_t *sm, uint8_t top, uint8_t target) {
+
+    const hsm_state_t *states = sm->def->states;
+    uint8_t            path[HSM_MAX_DEPTH];
+    int16_t            depth = 0;
+    uint8_t            state;
+
+    for( state = target; state != top && state != HSM_NONE && depth < HSM_MAX_DEPTH; state = states[state].parent ) {
+        path[depth++] = state;
+    }
+    while( depth > 0 ) {
+        state = path[--depth];
+        if( states[state].entry != NULL ) {
+            states[state].entry(sm);
+        }
+    }
+
+    while( states[target].initial != HSM_NONE ) {
+        target = states[target].initial;
+        if( states[target].entry != NULL ) {
+            states[target].entry(sm);
+        }
+    }
+    sm->state = target;
+}
+
+
+/************************************************************
+ * __hsm_exit
+ * Exits the states from the current state up to the top
+ * state (the top state is not exited).
+ ************************************************************/
+static void __hsm_exit(hsm_t *sm, uint8_t top) {
+
+    const hsm_state_t *states = sm->def->states;
+    uint8_t            state;
+
+    for( state = sm->state; state != top && state != HSM_NONE; state = states[state].parent ) {
+        if( states[state].exit != NULL ) {
+            states[state].exit(sm);
+        }
+    }
+}
+
+
+/************************************************************
+ * __hsm_common
+ * Returns the common parent of the source and the target,
+ * it is never the source or the target (external transition).
+ ************************************************************/
+static uint8_t __hsm_common(hsm_t *sm, uint8_t source, uint8_t target) {
+
+    uint8_t s, t;
+
+    for( s = __hsm_parent(sm, source); s != HSM_NONE; s = __hsm_parent(sm, s) ) {
+        for( t = __hsm_parent(sm, target); t != HSM_NONE; t = __hsm_parent(sm, t) ) {
+            if( s == t ) {
+                return s;
+            }
+        }
+    }
+    return HSM_NONE;
+}
+
+
+/************************************************************
+ * __hsm_check
+ * Returns true if the tables are valid:
+ * - The depth of every state is within HSM_MAX_DEPTH.
+ * - The initial sub-state is HSM_NONE or a direct child,
+ *   so the initial transitions always end.
+ * - The transition targets are states, HSM_NONE or
+ *   HSM_INTERNAL.
+ ************************************************************/
+static bool __hsm_check(const hsm_def_t *def) {
+
+    const hsm_transition_t *tr = def->transitions;
+    uint8_t                 state, initial;
+    uint16_t                i, count;
+
+    if( def->initial >= def->state_count ) {
+        return false;
+    }
+
+    for( state = 0; state < def->state_count; state++ ) {
+        if( __hsm_depth(def, state) == 0 ) {
+            return false;
+        }
+        initial = def->states[state].initial;
+        if( initial != HSM_NONE && (initial >= def->state_count || def->states[initial].parent != state) ) {
+            return false;
+        }
+    }
+
+    count = (uint16_t)def->state_count * def->event_count;
+    for( i = 0; i < count; i++ ) {
+        if( tr[i].target >= def->state_count && tr[i].target != HSM_NONE && tr[i].target != HSM_INTERNAL ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/************************************************************
+ * Hsm_Init
+ ************************************************************/
+bool Hsm_Init(hsm_t *sm, const hsm_def_t *def, void *context) {
+
+    sm->def     = def;
+    sm->context = context;
+    sm->state   = HSM_NONE;
+
+    if( !__hsm_check(def) ) {
+        return false;
+    }
+
+    __hsm_enter(sm, HSM_NONE, def->initial);
+    return true;
+}
+
+
+/************************************************************
+ * Hsm_Dispatch
+ * The transition is found by indexing the table of the
+ * state, the parents are only visited if it is not handled.
+ ************************************************************/
+bool Hsm_Dispatch(hsm_t *sm, uint8_t event, void *data) {
+
+    const hsm_def_t        *def = sm->def;
+    const hsm_transition_t *tr;
+    uint8_t                 source, top;
+
+    if( event >= def->event_count ) {
+        return false;
+    }
+
+    for( source = sm->state; source != HSM_NONE; source = __hsm_parent(sm, source) ) {
+
+        tr = &def->transitions[(uint16_t)source * def->event_count + event];
+        if( tr->target == HSM_NONE && tr->action == NULL ) {
+            continue;
+        }
+        if( tr->action != NULL && !tr->action(sm, event, data) ) {
+            continue;   // Rejected by the guard.
+        }
+        if( tr->target == HSM_NONE || tr->target == HSM_INTERNAL ) {
+            return true;
+        }
+
+        top = __hsm_common(sm, source, tr->target);
+        __hsm_exit(sm, top);
+        __hsm_enter(sm, top, tr->target);
+        return true;
+    }
+    return false;
+}
+
+
+/************************************************************
+ * Hsm_IsIn
+ ************************************************************/
+bool Hsm_IsIn(hsm_t *sm, uint8_t state) {
+    uint8_t s;
+    for( s = sm->state; s != HSM_NONE; s = __hsm_parent(sm, s) ) {
+        if( s == state ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/************************************************************
+ * __hsm_bind
+ * Returns a free binding of the machine and the event.
+ ************************************************************/
+static hsm_binding_t * __hsm_bind(hsm_t *sm, uint8_t event) {
+    int16_t i;
+    for( i = 0; i < RTL_CONFIG_HSM_BINDINGS; i++ ) {
+        if( __bindings[i].sm == NULL ) {
+            __bindings[i].sm     = sm;
+            __bindings[i].event  = event;
+            __bindings[i].handle = -1;
+            __bindings[i].timer  = NULL;
+            return &__bindings[i];
+        }
+    }
+    return NULL;
+}
+
+
+/************************************************************
+ * __hsm_unbind
+ * Removes the source of the binding and frees it.
+ ************************************************************/
+static void __hsm_unbind(hsm_binding_t *b) {
+    if( b->handle >= 0 ) {
+        Bus_Unsubscribe(b->handle);
+    }
+    else if( b->timer != NULL ) {
+        Timer_Delete(b->timer);
+    }
+    b->sm     = NULL;
+    b->handle = -1;
+    b->timer  = NULL;
+}
+
+
+/************************************************************
+ * __hsm_topic_relay, __hsm_timer_relay
+ * Dispatches the event of the source to the bound machine.
+ ************************************************************/
+static void __hsm_topic_relay(void *evt) {
+    bus_event_t   *be = (bus_event_t *)evt;
+    hsm_binding_t *b  = (hsm_binding_t *)be->context;
+    Hsm_Dispatch(b->sm, b->event, be->data);
+}
+
+static void __hsm_timer_relay(void *evt) {
+    timer_event_t *te = (timer_event_t *)evt;
+    hsm_binding_t *b  = (hsm_binding_t *)te->context;
+    // An alarm posted before the timer was deleted is ignored.
+    if( b->sm != NULL && b->timer == te->sender ) {
+        Hsm_Dispatch(b->sm, b->event, te);
+    }
+}
+
+
+/************************************************************
+ * Hsm_BindTopic
+ ************************************************************/
+bool Hsm_BindTopic(hsm_t *sm, uint16_t topic, uint8_t event) {
+
+    hsm_binding_t *b = __hsm_bind(sm, event);
+
+    if( b == NULL ) {
+        return false;
+    }
+    b->topic  = topic;
+    b->handle = Bus_Subscribe(topic, __hsm_topic_relay, b);
+    if( b->handle < 0 ) {
+        __hsm_unbind(b);
+        return false;
+    }
+    return true;
+}
+
+
+/************************************************************
+ * Hsm_UnbindTopic
+ ************************************************************/
+void Hsm_UnbindTopic(hsm_t *sm, uint16_t topic) {
+    int16_t i;
+    for( i = 0; i < RTL_CONFIG_HSM_BINDINGS; i++ ) {
+        if( __bindings[i].sm == sm && __bindings[i].handle >= 0 && __bindings[i].topic == topic ) {
+            __hsm_unbind(&__bindings[i]);
+        }
+    }
+}
+
+
+/************************************************************
+ * Hsm_CreateTimer
+ ************************************************************/
+timer_t * Hsm_CreateTimer(hsm_t *sm, uint32_t interval, uint8_t event, uint8_t mode) {
+
+    hsm_binding_t *b = __hsm_bind(sm, event);
+    timer_t       *timer;
+
+    if( b == NULL ) {
+        return NULL;
+    }
+    timer = Timer_CreateWithContext(interval, __hsm_timer_relay, b);
+    if( timer == NULL ) {
+        __hsm_unbind(b);
+        return NULL;
+    }
+    b->timer = timer;
+    Timer_SetMode(timer, mode);
+    return timer;
+}
+
+
+/************************************************************
+ * Hsm_DeleteTimer
+ ************************************************************/
+void Hsm_DeleteTimer(timer_t *timer) {
+    int16_t i;
+    if( timer == NULL ) {
+        return;
+    }
+    for( i = 0; i < RTL_CONFIG_HSM_BINDINGS; i++ ) {
+        if( __bindings[i].sm != NULL && __bindings[i].timer == timer ) {
+            __hsm_unbind(&__bindings[i]);
+            return;
+        }
+    }
+}
+
+
+/************************************************************
+ * Hsm_Unbind
+ ************************************************************/
+void Hsm_Unbind(hsm_t *sm) {
+    int16_t i;
+    for( i = 0; i < RTL_CONFIG_HSM_BINDINGS; i++ ) {
+        if( __bindings[i].sm == sm ) {
+            __hsm_unbind(&__bindings[i]);
+        }
+    }
+}
@@ -0,0 +1,161 @@
+/************************************************************
+ * File:    RTL_IsrTimer.c                                  *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_IsrTimer.h>
+#include <BSP_Mcu.h>
+
+#if RTL_CONFIG_MAX_ISR_TIMERS > 16
+    #error "RTL_CONFIG_MAX_ISR_TIMERS must not be greater than 16"
+#endif
+
+/*******************************************************
+ * ISR timer objects
+ * - __timers: ISR timers, a timer is free when its
+ *             callback is NULL.
+ * - __active: Bit mask of the running timers.
+ *******************************************************/
+static isr_timer_t          __timers[RTL_CONFIG_MAX_ISR_TIMERS];
+static volatile uint16_t    __active;
+
+
+/************************************************************
+ * IsrTimer_Create
+ ************************************************************/
+isr_timer_t * IsrTimer_Create(uint16_t interval, callback_t callback, void *context, uint16_t budget_us) {
+
+    isr_timer_t *timer;
+    int16_t      i;
+
+    if( callback == NULL ) {
+        return NULL;
+    }
+
+    for( i = 0; i < RTL_CONFIG_MAX_ISR_TIMERS; i++ ) {
+        timer = &__timers[i];
+        if( timer->callback == NULL ) {
+            if( budget_us > ISR_TIMER_MAX_BUDGET_US ) {
+                budget_us = ISR_TIMER_MAX_BUDGET_US;
+            }
+            timer->id       = i;
+            timer->interval = (interval == 0) ? 1 : interval;
+            timer->counter  = 0;
+            timer->budget   = budget_us << CLOCK_US_SHIFT;
+            timer->last_us  = 0;
+            timer->max_us   = 0;
+            timer->context  = context;
+            timer->callback = callback;
+            IsrTimer_Start(timer);
+            return timer;
+        }
+    }
+    return NULL;
+}
+
+
+/************************************************************
+ * IsrTimer_Delete
+ ************************************************************/
+void IsrTimer_Delete(isr_timer_t * timer) {
+    IsrTimer_Stop(timer);
+    timer->callback = NULL;
+    timer->context  = NULL;
+}
+
+
+/************************************************************
+ * IsrTimer_Start
+ ************************************************************/
+void IsrTimer_Start(isr_timer_t * timer) {
+    PERFORM_CRITICAL_SECTION( {
+        timer->ticks    = timer->interval;
+        timer->overruns = 0;
+        __active |= (1u << timer->id);
+    } );
+}
+
+
+/************************************************************
+ * IsrTimer_Stop
+ ************************************************************/
+void IsrTimer_Stop(isr_timer_t * timer) {
+    PERFORM_CRITICAL_SECTION( __active &= ~(1u << timer->id) );
+}
+
+
+/************************************************************
+ * IsrTimer_IsActive
+ ************************************************************/
+bool IsrTimer_IsActive(isr_timer_t * timer) {
+    return (__active & (1u << timer->id)) != 0;
+}
+
+
+/************************************************************
+ * IsrTimer_IsIdle
+ ************************************************************/
+bool IsrTimer_IsIdle(void) {
+    return __active == 0;
+}
+
+
+/************************************************************
+ * IsrTimer_TickIsrExecutor
+ * Only the running timers are visited (ff1 on the mask).
+ ************************************************************/
+inline void IsrTimer_TickIsrExecutor(void) {
+
+    isr_timer_t       *timer;
+    isr_timer_event_t  evt;
+    uint16_t           mask, bit, id, begin, counts;
+
+    mask = __active;
+    while( mask != 0 ) {
+        id    = __builtin_ff1r(mask) - 1;
+        bit   = 1u << id;
+        mask &= ~bit;
+        timer = &__timers[id];
+
+        // Stopped by a callback of the other timer.
+        if( (__active & bit) == 0 ) {
+            continue;
+        }
+
+        if( --timer->ticks != 0 ) {
+            continue;
+        }
+        timer->ticks = timer->interval;
+
+        timer->counter++;
+        evt.type    = EVT_ISR_TIMER_ALARM;
+        evt.id      = id;
+        evt.counter = timer->counter;
+        evt.context = timer->context;
+        evt.sender  = timer;
+
+        begin  = CLOCK_STAMP_COUNTS();
+        timer->callback(&evt);
+        counts = CLOCK_STAMP_COUNTS() - begin;
+
+        timer->last_us = CLOCK_COUNTS_TO_US(counts);
+        if( timer->last_us > timer->max_us ) {
+            timer->max_us = timer->last_us;
+        }
+
+        // The exceeded budget is counted, the timer is stopped at the limit.
+        if( timer->budget > 0 && counts > timer->budget ) {
+            if( timer->overruns < 0xFFFF ) {
+                timer->overruns++;
+            }
+        #if RTL_CONFIG_ISR_TIMER_OVERRUN_LIMIT > 0
+            if( timer->overruns >= RTL_CONFIG_ISR_TIMER_OVERRUN_LIMIT ) {
+                __active &= ~bit;
+            }
+        #endif
+        }
+    }
+}
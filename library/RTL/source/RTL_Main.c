@@ -0,0 +1,81 @@
+/************************************************************
+ * File:    RTL_Main.c                                      *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_Main.h>
+#include <RTL_Timer.h>
+#include <RTL_IsrTimer.h>
+#include <RTL_Bus.h>
+#include <RTL_Thread.h>
+#include <BSP_Mcu.h>
+
+/*******************************************************
+ * Number of system ticks not executed yet
+ *******************************************************/
+static volatile uint16_t rtl_isr_ticks;
+
+
+/************************************************************
+ * RTL_TickIsrExecutor
+ ************************************************************/
+inline void RTL_TickIsrExecutor(void) {
+    rtl_isr_ticks++;
+    IsrTimer_TickIsrExecutor();
+}
+
+
+/************************************************************
+ * RTL_TickIsrAddTicks
+ ************************************************************/
+void RTL_TickIsrAddTicks(uint16_t ticks) {
+    PERFORM_CRITICAL_SECTION( rtl_isr_ticks += ticks );
+}
+
+
+/************************************************************
+ * RTL_GetIdleTicks
+ ************************************************************/
+uint16_t RTL_GetIdleTicks(void) {
+    if( RTL_IsPending() || !IsrTimer_IsIdle() || !Thread_IsIdle() ) {
+        return 0;
+    }
+    return Timer_GetIdleTicks();
+}
+
+
+/************************************************************
+ * RTL_GetPendingTicks
+ ************************************************************/
+uint16_t RTL_GetPendingTicks(void) {
+    return rtl_isr_ticks;
+}
+
+
+/************************************************************
+ * RTL_IsPending
+ ************************************************************/
+bool RTL_IsPending(void) {
+    return rtl_isr_ticks > 0 || Bus_IsPending() || Thread_IsPending();
+}
+
+
+/************************************************************
+ * RTL_Executor
+ * All pending ticks are executed, the timers handle their
+ * late alarms by their overrun policies. Then one batch of
+ * the bus events is delivered and the threads are performed.
+ ************************************************************/
+inline void RTL_Executor(void) {
+    bool ticked = false;
+    while( rtl_isr_ticks > 0 ) {
+        PERFORM_CRITICAL_SECTION( rtl_isr_ticks-- );
+        Timer_TickedExecutor();
+        ticked = true;
+    }
+    Bus_Executor();
+    Thread_Executor(ticked);
+}
@@ -0,0 +1,339 @@
+/************************************************************
+ * File:    RTL_Pid.c                                       *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_Pid.h>
+#include <BSP_Mcu.h>
+#include <BSP_Adc.h>
+#include <BSP_Pwm.h>
+
+#if RTL_CONFIG_PID_LOOPS > 16
+    #error "RTL_CONFIG_PID_LOOPS must not be greater than 16"
+#endif
+
+/*******************************************************
+ * Duty cycle registers of the PWM channels
+ *******************************************************/
+static volatile unsigned int * const __pwm_duty[PWM_NUM_CHANNELS] = {
+    &OC1RS, &OC2RS, &OC3RS, &OC4RS
+};
+
+/*******************************************************
+ * Prescaler shifts of the Timer2 (1:1, 1:8, 1:64, 1:256)
+ *******************************************************/
+static const uint8_t __t2_shifts[4] = { 0, 3, 6, 8 };
+
+/*******************************************************
+ * Loop objects
+ * - __loops:  Registered loops, a slot is free when NULL.
+ * - __active: Bit mask of the running loops.
+ *******************************************************/
+static pid_loop_t * volatile __loops[RTL_CONFIG_PID_LOOPS];
+static volatile uint16_t     __active;
+
+
+/************************************************************
+ * __pid_write
+ * Writes the Q15 duty cycle, the PWM period is PR2+1.
+ ************************************************************/
+static inline void __pid_write(uint16_t id, q15_t duty) {
+    uint16_t d = (duty > 0) ? (uint16_t)duty : 0;
+    *__pwm_duty[id] = (uint16_t)((__builtin_muluu(d, PR2) + d) >> 15);
+}
+
+
+/************************************************************
+ * __pid_period
+ * Returns the expected period of the loop in Timer5 counts
+ * (modulo 65536), it follows the Pwm_SetFrequency().
+ ************************************************************/
+static inline uint16_t __pid_period(pid_loop_t *loop) {
+    uint32_t cycles = __builtin_muluu(PR2, loop->interval) + loop->interval;
+    return (uint16_t)((cycles << __t2_shifts[T2CONbits.TCKPS]) / CLOCK_PRESCALE);
+}
+
+
+/************************************************************
+ * __pid_run (Timer2 ISR context)
+ * One run of the loop.
+ ************************************************************/
+static inline void __pid_run(pid_loop_t *loop) {
+
+    uint16_t stamp = CLOCK_STAMP_COUNTS();
+    uint16_t error, exec;
+    int16_t  jitter;
+
+    // The period error of the run, the first run has no period.
+    if( loop->runs != 0 ) {
+        jitter = (int16_t)(stamp - loop->stamp - __pid_period(loop));
+        error  = (jitter < 0) ? -jitter : jitter;
+        loop->jitter = jitter;
+        if( error > loop->jitter_max ) {
+            loop->jitter_max = error;
+        }
+    }
+    loop->stamp = stamp;
+    loop->runs++;
+
+    // The 10-bit ADC value is scaled to Q15.
+    __pid_write(loop->pwm_id, Pid_Update(loop, (q15_t)(Adc_Get(loop->adc_id) << 5)));
+
+    exec = CLOCK_STAMP_COUNTS() - stamp;
+    loop->exec = exec;
+    if( exec > loop->exec_max ) {
+        loop->exec_max = exec;
+    }
+    if( exec > (RTL_CONFIG_PID_BUDGET_US << CLOCK_US_SHIFT) && loop->overruns < 0xFFFF ) {
+        loop->overruns++;
+    }
+}
+
+
+/************************************************************
+ * __pid_slot
+ * Returns the slot of the loop, a re-initialized loop keeps
+ * its slot. Returns -1 if all slots are used.
+ ************************************************************/
+static int16_t __pid_slot(pid_loop_t *loop) {
+
+    int16_t i, free = -1;
+
+    for( i = 0; i < RTL_CONFIG_PID_LOOPS; i++ ) {
+        if( __loops[i] == loop ) {
+            return i;
+        }
+        if( __loops[i] == NULL && free < 0 ) {
+            free = i;
+        }
+    }
+    return free;
+}
+
+
+/************************************************************
+ * Pid_Init
+ ************************************************************/
+bool Pid_Init(pid_loop_t *loop, uint16_t adc_id, uint16_t pwm_id, uint16_t interval) {
+
+    int16_t i;
+
+    loop->id = -1;
+    if( adc_id >= ADC_NUM_CHANNELS || pwm_id >= PWM_NUM_CHANNELS ) {
+        return false;
+    }
+
+    i = __pid_slot(loop);
+    if( i < 0 ) {
+        return false;
+    }
+
+    PERFORM_CRITICAL_SECTION( __active &= ~(1u << i) );
+
+    memset(loop, 0, sizeof(pid_loop_t));
+    loop->id       = i;
+    loop->adc_id   = adc_id;
+    loop->pwm_id   = pwm_id;
+    loop->interval = (interval == 0) ? 1 : interval;
+    loop->out_max  = Q15_MAX;
+    __loops[i]     = loop;
+    return true;
+}
+
+
+/************************************************************
+ * Pid_SetGains
+ ************************************************************/
+void Pid_SetGains(pid_loop_t *loop, q15_t kp, q15_t ki, q15_t kd, uint16_t shift) {
+    if( shift > PID_MAX_SHIFT ) {
+        shift = PID_MAX_SHIFT;
+    }
+    PERFORM_CRITICAL_SECTION( {
+        loop->kp    = kp;
+        loop->ki    = ki;
+        loop->kd    = kd;
+        loop->shift = shift;
+    } );
+}
+
+
+/************************************************************
+ * Pid_SetLimits
+ ************************************************************/
+void Pid_SetLimits(pid_loop_t *loop, q15_t min, q15_t max) {
+    PERFORM_CRITICAL_SECTION( {
+        loop->out_min = min;
+        loop->out_max = max;
+    } );
+}
+
+
+/************************************************************
+ * Pid_SetSetpoint
+ ************************************************************/
+void Pid_SetSetpoint(pid_loop_t *loop, q15_t setpoint) {
+    loop->setpoint = setpoint;
+}
+
+
+/************************************************************
+ * Pid_Start
+ ************************************************************/
+void Pid_Start(pid_loop_t *loop) {
+
+    if( loop->id < 0 ) {
+        return;
+    }
+
+    PERFORM_CRITICAL_SECTION( {
+        loop->integ  = 0;
+        loop->primed = false;
+        loop->ticks  = loop->interval;
+        Pid_ResetStats(loop);
+        __active |= (1u << loop->id);
+    } );
+
+    if( !IEC0bits.T2IE ) {
+        IPC1bits.T2IP = RTL_CONFIG_PID_ISR_PRIORITY;
+        IFS0bits.T2IF = 0;
+        IEC0bits.T2IE = 1;
+    }
+}
+
+
+/************************************************************
+ * Pid_Stop
+ ************************************************************/
+void Pid_Stop(pid_loop_t *loop) {
+    if( loop->id < 0 ) {
+        return;
+    }
+    PERFORM_CRITICAL_SECTION( __active &= ~(1u << loop->id) );
+    if( __active == 0 ) {
+        IEC0bits.T2IE = 0;
+    }
+}
+
+
+/************************************************************
+ * Pid_IsRunning
+ ************************************************************/
+bool Pid_IsRunning(pid_loop_t *loop) {
+    return loop->id >= 0 && (__active & (1u << loop->id)) != 0;
+}
+
+
+/************************************************************
+ * Pid_Update
+ * The terms are Q30 products of the Q15 gains and errors,
+ * their sum is shifted by (15 - shift) to the Q15 output.
+ * The derivative is taken on the measurement, a step of
+ * the setpoint does not kick the output.
+ ************************************************************/
+q15_t Pid_Update(pid_loop_t *loop, q15_t pv) {
+
+    uint16_t scale = 15 - loop->shift;
+    q15_t    error = Q15_Sub(loop->setpoint, pv);
+    q31_t    integ, sum, low, high;
+    q15_t    output;
+
+    // Integrator, clamped to the output limits.
+    low   = (q31_t)loop->out_min << scale;
+    high  = (q31_t)loop->out_max << scale;
+    integ = Q31_Add(loop->integ, __builtin_mulss(loop->ki, error));
+    if( integ > high ) {
+        integ = high;
+    }
+    else if( integ < low ) {
+        integ = low;
+    }
+
+    sum = Q31_Add(__builtin_mulss(loop->kp, error), integ);
+    if( loop->primed ) {
+        sum = Q31_Add(sum, __builtin_mulss(loop->kd, Q15_Sub(loop->pv, pv)));
+    }
+    output = Q15_Sat(sum >> scale);
+
+    // The integrator is held while the output is saturated by the error.
+    if( output >= loop->out_max ) {
+        output = loop->out_max;
+        if( error > 0 ) {
+            integ = loop->integ;
+        }
+    }
+    else if( output <= loop->out_min ) {
+        output = loop->out_min;
+        if( error < 0 ) {
+            integ = loop->integ;
+        }
+    }
+
+    loop->integ  = integ;
+    loop->pv     = pv;
+    loop->primed = true;
+    loop->output = output;
+    return output;
+}
+
+
+/************************************************************
+ * Pid_GetStats
+ ************************************************************/
+void Pid_GetStats(pid_loop_t *loop, pid_stats_t *stats) {
+
+    int16_t jitter;
+
+    PERFORM_CRITICAL_SECTION( {
+        stats->runs          = loop->runs;
+        jitter               = loop->jitter;
+        stats->jitter_max_us = CLOCK_COUNTS_TO_US(loop->jitter_max);
+        stats->exec_us       = CLOCK_COUNTS_TO_US(loop->exec);
+        stats->exec_max_us   = CLOCK_COUNTS_TO_US(loop->exec_max);
+        stats->overruns      = loop->overruns;
+    } );
+
+    stats->jitter_us = (jitter < 0) ? -(int16_t)CLOCK_COUNTS_TO_US((uint16_t)-jitter)
+                                    :  (int16_t)CLOCK_COUNTS_TO_US((uint16_t)jitter);
+}
+
+
+/************************************************************
+ * Pid_ResetStats
+ ************************************************************/
+void Pid_ResetStats(pid_loop_t *loop) {
+    PERFORM_CRITICAL_SECTION( {
+        loop->runs       = 0;
+        loop->jitter     = 0;
+        loop->jitter_max = 0;
+        loop->exec       = 0;
+        loop->exec_max   = 0;
+        loop->overruns   = 0;
+    } );
+}
+
+
+/************************************************************
+ * Timer2 Interrupt Service Routine (PWM period)
+ * The running loops are performed every interval periods.
+ ************************************************************/
+void __attribute__((interrupt, auto_psv)) _T2Interrupt(void) {
+
+    pid_loop_t *loop;
+    uint16_t    mask, id;
+
+    IFS0bits.T2IF = 0;
+
+    mask = __active;
+    while( mask != 0 ) {
+        id    = __builtin_ff1r(mask) - 1;
+        mask &= ~(1u << id);
+        loop  = __loops[id];
+        if( --loop->ticks == 0 ) {
+            loop->ticks = loop->interval;
+            __pid_run(loop);
+        }
+    }
+}
@@ -0,0 +1,235 @@
+/************************************************************
+ * File:    RTL_Thread.c                                    *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_Thread.h>
+#include <bsp.h>
+
+/*******************************************************
+ * Thread objects
+ * - __threads:   Running threads, in the creating order.
+ * - __wake:      A thread received its awaited event.
+ * - __executing: The executor is walking the list, the
+ *                killed threads are unlinked by it.
+ *******************************************************/
+static thread_t         *__threads;
+static volatile bool    __wake;
+static bool             __executing;
+
+
+/************************************************************
+ * __thread_unlisten
+ * Removes the subscription of the thread.
+ ************************************************************/
+static void __thread_unlisten(thread_t *thread) {
+    if( thread->listener >= 0 ) {
+        Bus_Unsubscribe(thread->listener);
+        thread->listener = -1;
+    }
+}
+
+
+/************************************************************
+ * __thread_listener
+ * Bus subscriber of the waiting threads. The event is kept
+ * until the thread takes it, the next events are ignored.
+ ************************************************************/
+static void __thread_listener(void *evt) {
+
+    bus_event_t  *be     = (bus_event_t *)evt;
+    thread_t     *thread = (thread_t *)be->context;
+    uart_event_t *ue;
+
+    if( thread->ready ) {
+        return;
+    }
+
+    if( thread->line == NULL ) {
+        memcpy(thread->event, be->data, be->size);
+        thread->ready = true;
+    }
+    else {
+        ue = (uart_event_t *)be->data;
+        if( ue->byte == '\r' || ue->byte == '\n' ) {
+            // The empty lines (e.g. the '\n' of the "\r\n") are ignored.
+            if( thread->line_len > 0 ) {
+                thread->line[thread->line_len] = '\0';
+                thread->ready = true;
+            }
+        }
+        else if( thread->line_len < thread->line_size - 1 ) {
+            thread->line[thread->line_len++] = ue->byte;
+        }
+    }
+
+    if( thread->ready ) {
+        __wake = true;
+    }
+}
+
+
+/************************************************************
+ * __thread_link
+ * Returns the link that points to the thread, or the end
+ * of the list if the thread is not linked.
+ ************************************************************/
+static thread_t ** __thread_link(thread_t *thread) {
+    thread_t **link = &__threads;
+    while( *link != NULL && *link != thread ) {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+
+/************************************************************
+ * Thread_Create
+ * A linked thread keeps its place in the list.
+ ************************************************************/
+void Thread_Create(thread_t *thread, thread_fn_t function, void *context) {
+
+    thread_t **link = __thread_link(thread);
+
+    if( *link == thread ) {
+        __thread_unlisten(thread);
+    }
+    else {
+        thread->next = NULL;
+        *link        = thread;
+    }
+
+    thread->lc       = 0;
+    thread->function = function;
+    thread->context  = context;
+    thread->deadline = 0;
+    thread->listener = -1;
+    thread->ready    = false;
+    thread->line     = NULL;
+}
+
+
+/************************************************************
+ * Thread_Kill
+ * The thread is unlinked by the executor if it is running,
+ * its next link stays valid for the executor.
+ ************************************************************/
+void Thread_Kill(thread_t *thread) {
+
+    thread_t **link;
+
+    if( !__executing ) {
+        link = __thread_link(thread);
+        if( *link == thread ) {
+            *link = thread->next;
+        }
+    }
+    __thread_unlisten(thread);
+    thread->function = NULL;
+}
+
+
+/************************************************************
+ * Thread_IsAlive
+ ************************************************************/
+bool Thread_IsAlive(thread_t *thread) {
+    return thread->function != NULL;
+}
+
+
+/************************************************************
+ * Thread_Listen
+ ************************************************************/
+bool Thread_Listen(thread_t *thread, uint16_t topic, char *line, uint16_t size) {
+
+    thread->ready     = false;
+    thread->line      = (size > 0) ? line : NULL;
+    thread->line_size = size;
+    thread->line_len  = 0;
+
+    if( thread->listener >= 0 && thread->topic != topic ) {
+        __thread_unlisten(thread);
+    }
+    if( thread->listener < 0 ) {
+        thread->topic    = topic;
+        thread->listener = Bus_Subscribe(topic, __thread_listener, thread);
+    }
+    return thread->listener >= 0;
+}
+
+
+/************************************************************
+ * Thread_IsReady
+ ************************************************************/
+bool Thread_IsReady(thread_t *thread) {
+    if( !thread->ready ) {
+        return false;
+    }
+    __thread_unlisten(thread);
+    return true;
+}
+
+
+/************************************************************
+ * Thread_IsExpired
+ ************************************************************/
+bool Thread_IsExpired(thread_t *thread) {
+    return (int32_t)(Timer_GetTicks() - thread->deadline) >= 0;
+}
+
+
+/************************************************************
+ * Thread_IsPending
+ ************************************************************/
+bool Thread_IsPending(void) {
+    return __wake;
+}
+
+
+/************************************************************
+ * Thread_IsIdle
+ ************************************************************/
+bool Thread_IsIdle(void) {
+    return __threads == NULL;
+}
+
+
+/************************************************************
+ * Thread_Executor
+ ************************************************************/
+inline void Thread_Executor(bool ticked) {
+
+    thread_t **link, *thread;
+    char       status;
+
+    if( !ticked && !__wake ) {
+        return;
+    }
+    __wake      = false;
+    __executing = true;
+
+    link = &__threads;
+    while( (thread = *link) != NULL ) {
+
+        // Killed in this pass (or by itself), it is unlinked.
+        if( thread->function == NULL ) {
+            *link = thread->next;
+            continue;
+        }
+
+        if( ticked || thread->ready ) {
+            status = thread->function(thread);
+            if( status == PT_EXITED || status == PT_ENDED ) {
+                Thread_Kill(thread);
+                *link = thread->next;
+                continue;
+            }
+        }
+        link = &thread->next;
+    }
+
+    __executing = false;
+}
@@ -0,0 +1,505 @@
+/************************************************************
+ * File:    RTL_Timer.c                                     *
+ * Author:  Asst.Prof.Dr.Santi Nuratch                      *
+ *          Embedded Computing and Control Laboratory       *
+ *          ECC-Lab, INC, KMUTT, Thailand                   *
+ * Update:  19 October 2026                                 *
+ ************************************************************/
+
+#include <RTL_Timer.h>
+#include <RTL_Main.h>
+#include <BSP_Dispatch.h>
+
+/*******************************************************
+ * Slot index mask and the range of the wheel (ticks)
+ *******************************************************/
+#define TIMER_WHEEL_MASK    (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_RANGE   (1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+/*******************************************************
+ * Timer objects
+ * - __timers: Timer pool, the id is the index of the timer.
+ * - __free:   Free timers, linked by the next.
+ * - __static_id: Id of the next static timer, the ids of the
+ *             static timers follow the ids of the pool.
+ * - __wheel:  Slots of the timing wheel, lists of the timers.
+ * - __ticks:  Next tick to be processed, the current tick
+ *             is (__ticks - 1).
+ *******************************************************/
+static timer_t      __timers[RTL_CONFIG_MAX_TIMERS];
+static timer_t      *__free;
+static int          __static_id = RTL_CONFIG_MAX_TIMERS;
+static bool         __initialized = false;
+static timer_t      *__wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+static uint32_t     __ticks = 1;
+
+
+/************************************************************
+ * __timer_init
+ * Links all timers into the free list.
+ ************************************************************/
+static void __timer_init(void) {
+    int16_t i;
+    __free = NULL;
+    for( i = RTL_CONFIG_MAX_TIMERS - 1; i >= 0; i-- ) {
+        memset(&__timers[i], 0, sizeof(timer_t));
+        __timers[i].id   = -1;
+        __timers[i].next = __free;
+        __free = &__timers[i];
+    }
+    __initialized = true;
+}
+
+
+/************************************************************
+ * __timer_link
+ * Inserts the timer at the head of the list.
+ ************************************************************/
+static void __timer_link(timer_t **head, timer_t *timer) {
+    timer->next = *head;
+    if( timer->next != NULL ) {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    *head = timer;
+}
+
+
+/************************************************************
+ * __timer_unlink
+ * Removes the timer from its list (if it is linked).
+ ************************************************************/
+static void __timer_unlink(timer_t *timer) {
+    if( timer->pprev == NULL ) {
+        return;
+    }
+    *timer->pprev = timer->next;
+    if( timer->next != NULL ) {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->next  = NULL;
+    timer->pprev = NULL;
+}
+
+
+/************************************************************
+ * __timer_insert
+ * Inserts the timer into the slot of its expiry tick. The
+ * level is selected by the distance to the expiry tick.
+ * An expired timer is placed in the slot of the next tick.
+ * A timer beyond the range of the wheel is placed in the
+ * last slot of the top level, it is cascaded again later.
+ ************************************************************/
+static void __timer_insert(timer_t *timer) {
+
+    uint32_t expires = timer->expires;
+    int32_t  delta   = (int32_t)(expires - __ticks);
+    uint16_t level;
+
+    if( delta < 0 ) {
+        __timer_link(&__wheel[0][__ticks & TIMER_WHEEL_MASK], timer);
+        return;
+    }
+
+    if( (uint32_t)delta >= TIMER_WHEEL_RANGE ) {
+        expires = __ticks + TIMER_WHEEL_RANGE - 1;
+        delta   = TIMER_WHEEL_RANGE - 1;
+    }
+
+    for( level = 0; level < TIMER_WHEEL_LEVELS - 1; level++ ) {
+        if( (uint32_t)delta < (1UL << (TIMER_WHEEL_BITS * (level + 1))) ) {
+            break;
+        }
+    }
+
+    __timer_link(&__wheel[level][(expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK], timer);
+}
+
+
+/************************************************************
+ * __timer_cascade
+ * Moves the timers of the slot to the lower levels.
+ * Returns the index of the slot.
+ ************************************************************/
+static uint16_t __timer_cascade(uint16_t level) {
+
+    uint16_t index = (__ticks >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+    timer_t  *list = __wheel[level][index];
+    timer_t  *timer;
+
+    __wheel[level][index] = NULL;
+    while( list != NULL ) {
+        timer = list;
+        list  = list->next;
+        __timer_insert(timer);
+    }
+    return index;
+}
+
+
+/************************************************************
+ * __timer_arm
+ * Inserts the timer with the given deadline, the timer is
+ * removed from its current slot first.
+ ************************************************************/
+static void __timer_arm(timer_t *timer, uint32_t deadline) {
+    __timer_unlink(timer);
+    timer->expires = deadline;
+    timer->active  = true;
+    __timer_insert(timer);
+}
+
+
+/************************************************************
+ * __timer_interval
+ * Limits the interval to 1 - TIMER_MAX_INTERVAL.
+ ************************************************************/
+static uint32_t __timer_interval(uint32_t interval) {
+    if( interval == 0 ) {
+        return 1;
+    }
+    return (interval > TIMER_MAX_INTERVAL) ? TIMER_MAX_INTERVAL : interval;
+}
+
+
+/************************************************************
+ * __timer_setup
+ * Initializes the timer object and starts it.
+ ************************************************************/
+static timer_t * __timer_setup(timer_t *timer, int id, uint32_t interval, callback_t callback, void *context, uint8_t mode) {
+    timer->id       = id;
+    timer->interval = __timer_interval(interval);
+    timer->mode     = mode;
+    timer->counter  = 0;
+    timer->callback = callback;
+    timer->context  = context;
+    timer->policy   = TIMER_OVERRUN_CATCHUP;
+    timer->overruns = 0;
+    timer->late_max = 0;
+    timer->next     = NULL;
+    timer->pprev    = NULL;
+    __timer_arm(timer, Timer_GetTicks() + timer->interval);
+    return timer;
+}
+
+
+/************************************************************
+ * __timer_create
+ * Takes a timer from the pool and starts it.
+ ************************************************************/
+static timer_t * __timer_create(uint32_t interval, callback_t callback, void *context, uint8_t mode) {
+
+    timer_t *timer;
+
+    if( !__initialized ) {
+        __timer_init();
+    }
+
+    if( __free == NULL || callback == NULL ) {
+        return NULL;
+    }
+
+    timer  = __free;
+    __free = timer->next;
+
+    return __timer_setup(timer, timer - __timers, interval, callback, context, mode);
+}
+
+
+/************************************************************
+ * __timer_is_pooled
+ * Returns true if the timer is taken from the pool.
+ ************************************************************/
+static bool __timer_is_pooled(timer_t *timer) {
+    return timer >= __timers && timer < &__timers[RTL_CONFIG_MAX_TIMERS];
+}
+
+
+/************************************************************
+ * Timer_Create
+ ************************************************************/
+timer_t * Timer_Create(uint32_t interval, callback_t callback) {
+    return __timer_create(interval, callback, NULL, TIMER_MODE_PERIODIC);
+}
+
+
+/************************************************************
+ * Timer_CreateWithContext
+ ************************************************************/
+timer_t * Timer_CreateWithContext(uint32_t interval, callback_t callback, void *context) {
+    return __timer_create(interval, callback, context, TIMER_MODE_PERIODIC);
+}
+
+
+/************************************************************
+ * Timer_CreateOneShot
+ ************************************************************/
+timer_t * Timer_CreateOneShot(uint32_t interval, callback_t callback) {
+    return __timer_create(interval, callback, NULL, TIMER_MODE_ONESHOT);
+}
+
+
+/************************************************************
+ * Timer_CreateStatic
+ ************************************************************/
+timer_t * Timer_CreateStatic(timer_t *timer, uint32_t interval, callback_t callback, void *context) {
+
+    if( timer == NULL || callback == NULL ) {
+        return NULL;
+    }
+
+    return __timer_setup(timer, __static_id++, interval, callback, context, TIMER_MODE_PERIODIC);
+}
+
+
+/************************************************************
+ * Timer_SetMode
+ ************************************************************/
+void Timer_SetMode(timer_t * timer, uint8_t mode) {
+    timer->mode = mode;
+}
+
+
+/************************************************************
+ * Timer_SetOverrunPolicy
+ ************************************************************/
+void Timer_SetOverrunPolicy(timer_t * timer, uint8_t policy) {
+    timer->policy = policy;
+}
+
+
+/************************************************************
+ * Timer_ResetOverruns
+ ************************************************************/
+void Timer_ResetOverruns(timer_t * timer) {
+    timer->overruns = 0;
+    timer->late_max = 0;
+}
+
+
+/************************************************************
+ * Timer_Delete
+ ************************************************************/
+void Timer_Delete(timer_t * timer) {
+
+    if( timer == NULL || timer->callback == NULL ) {
+        return;
+    }
+
+    __timer_unlink(timer);
+    timer->id       = -1;
+    timer->interval = 0;
+    timer->mode     = TIMER_MODE_PERIODIC;
+    timer->active   = false;
+    timer->counter  = 0;
+    timer->callback = NULL;
+    timer->context  = NULL;
+
+    // The storage of a static timer belongs to the application.
+    if( __timer_is_pooled(timer) ) {
+        timer->next = __free;
+        __free = timer;
+    }
+}
+
+
+/************************************************************
+ * Timer_Start
+ ************************************************************/
+void Timer_Start(timer_t * timer) {
+    if( !timer->active ) {
+        __timer_arm(timer, Timer_GetTicks() + timer->interval);
+    }
+}
+
+
+/************************************************************
+ * Timer_StartAt
+ ************************************************************/
+void Timer_StartAt(timer_t * timer, uint32_t deadline) {
+    __timer_arm(timer, deadline);
+}
+
+
+/************************************************************
+ * Timer_Stop
+ ************************************************************/
+void Timer_Stop(timer_t * timer) {
+    __timer_unlink(timer);
+    timer->active = false;
+}
+
+
+/************************************************************
+ * Timer_Reset
+ ************************************************************/
+void Timer_Reset(timer_t * timer) {
+    __timer_arm(timer, Timer_GetTicks() + timer->interval);
+}
+
+
+/************************************************************
+ * Timer_ChangePeriod
+ ************************************************************/
+void Timer_ChangePeriod(timer_t * timer, uint32_t interval) {
+    timer->interval = __timer_interval(interval);
+    __timer_arm(timer, Timer_GetTicks() + timer->interval);
+}
+
+
+/************************************************************
+ * Timer_IsActive
+ ************************************************************/
+bool Timer_IsActive(timer_t * timer) {
+    return timer->active;
+}
+
+
+/************************************************************
+ * Timer_GetTicks
+ ************************************************************/
+uint32_t Timer_GetTicks(void) {
+    return __ticks - 1;
+}
+
+
+/************************************************************
+ * Timer_GetIdleTicks
+ * All slots are visited, it is only called before the idle.
+ ************************************************************/
+uint16_t Timer_GetIdleTicks(void) {
+
+    timer_t  *timer;
+    uint16_t  level, index;
+    int32_t   ticks, min = 0xFFFF;
+
+    for( level = 0; level < TIMER_WHEEL_LEVELS; level++ ) {
+        for( index = 0; index < TIMER_WHEEL_SLOTS; index++ ) {
+            for( timer = __wheel[level][index]; timer != NULL; timer = timer->next ) {
+                // The timer is alarmed when the __ticks reaches its deadline.
+                ticks = (int32_t)(timer->expires - __ticks);
+                if( ticks <= 0 ) {
+                    return 0;
+                }
+                if( ticks < min ) {
+                    min = ticks;
+                }
+            }
+        }
+    }
+    return (uint16_t)min;
+}
+
+
+/************************************************************
+ * __timer_overrun
+ * Measures the lateness of the alarm and applies the overrun
+ * policy of the timer. The lateness includes the ticks that
+ * are not executed yet by the RTL_Executor().
+ * Returns the number of missed alarms.
+ ************************************************************/
+static uint16_t __timer_overrun(timer_t *timer, uint16_t *late) {
+
+    uint32_t ticks = Timer_GetTicks() - timer->expires + RTL_GetPendingTicks();
+    uint32_t missed;
+
+    *late = (ticks > 0xFFFF) ? 0xFFFF : (uint16_t)ticks;
+    if( *late > timer->late_max ) {
+        timer->late_max = *late;
+    }
+
+    if( timer->mode != TIMER_MODE_PERIODIC || timer->policy == TIMER_OVERRUN_CATCHUP || ticks < timer->interval ) {
+        return 0;
+    }
+
+    // The deadlines that are already passed, the next one keeps the phase.
+    missed = ticks / timer->interval;
+    timer->expires += missed * timer->interval;
+    if( missed > 0xFFFF ) {
+        missed = 0xFFFF;
+    }
+
+    timer->overruns = (timer->overruns > 0xFFFF - missed) ? 0xFFFF : timer->overruns + missed;
+    if( timer->policy == TIMER_OVERRUN_COALESCE ) {
+        timer->counter += missed;
+    }
+    return missed;
+}
+
+
+/************************************************************
+ * Timer_TickedExecutor
+ * Only the timers of one slot are touched, the expired
+ * timers are detached into a local list first, so the
+ * callbacks may create and delete any timer. The alarms
+ * are posted to the dispatcher (RTL_CONFIG_TIMER_DISPATCH),
+ * the callbacks are performed by the BSP_Executor.
+ ************************************************************/
+inline void Timer_TickedExecutor(void) {
+
+    timer_t       *expired, *timer;
+    timer_event_t  evt;
+    uint16_t       index, level, missed, late;
+
+    /*********************************
+     * Cascade the higher levels when
+     * the level 0 is wrapped
+     *********************************/
+    index = __ticks & TIMER_WHEEL_MASK;
+    if( index == 0 ) {
+        for( level = 1; level < TIMER_WHEEL_LEVELS; level++ ) {
+            if( __timer_cascade(level) != 0 ) {
+                break;
+            }
+        }
+    }
+    __ticks++;
+
+    /*********************************
+     * Detach the expired timers
+     *********************************/
+    expired = __wheel[0][index];
+    __wheel[0][index] = NULL;
+    if( expired != NULL ) {
+        expired->pprev = &expired;
+    }
+
+    /*********************************
+     * Perform the callbacks
+     *********************************/
+    while( expired != NULL ) {
+        timer = expired;
+        __timer_unlink(timer);
+
+        // The one-shot timer is stopped before its callback, so it can be restarted.
+        if( timer->mode == TIMER_MODE_ONESHOT ) {
+            timer->active = false;
+        }
+
+        missed = __timer_overrun(timer, &late);
+
+        timer->counter++;
+        evt.type    = EVT_TIMER_ALARM;
+        evt.id      = timer->id;
+        evt.counter = timer->counter;
+        evt.context = timer->context;
+        evt.sender  = timer;
+        evt.missed  = missed;
+        evt.late    = late;
+    #if RTL_CONFIG_TIMER_DISPATCH > 0
+        // A dropped alarm is counted as a missed alarm.
+        if( !Dispatch_Post(timer->callback, &evt, sizeof(evt)) && timer->overruns < 0xFFFF ) {
+            timer->overruns++;
+        }
+    #else
+        timer->callback(&evt);
+    #endif
+
+        // The timer may be stopped, restarted or deleted by its callback.
+        // The next deadline is computed from the previous one, no drift.
+        if( timer->active && timer->pprev == NULL ) {
+            timer->expires += timer->interval;
+            __timer_insert(timer);
+        }
+    }
+}
@@ -57,6 +57,35 @@
 #define configIDLE_SHOULD_YIELD             1
 #define configCHECK_FOR_STACK_OVERFLOW      2
 
+/* Tickless idle. The tick is suppressed while the tasks and the BSP are idle
+(see vPortSuppressTicksAndSleep in the port.c and the hooks in the ecc.c). The
+tasks.c and port.c must be compiled from the sources (see the config.cfg), the
+prebuilt RTOS library does not contain the tickless idle. The co-routine delays
+are not considered by the kernel, they can be extended by the idle time.
+The BSP_TICKLESS_IDLE (BSP_Config.h) must have the same value. It sets the
+Timer5 clock (BSP_Clock.h) to 0.5uS counts, its overflow interrupt (above
+the kernel priority) wakes the sleep every 32.768mS instead of every 4.096mS
+(a sleep of up to 32 ticks), the profiler and the timestamps lose the cycle
+resolution. */
+#define configUSE_TICKLESS_IDLE                 1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+#define configPRE_SLEEP_PROCESSING( x )         vApplicationPreSleepProcessing( &( x ) )
+#define configPOST_SLEEP_PROCESSING( x )        vApplicationPostSleepProcessing( x )
+
+/* CPU load meter (see the BSP_Load.h). The time of the idle task is accounted
+as idle, the co-routine (ecc.c) marks its own work as busy. The macros are
+expanded in the tasks.c only. Set to 0 to build the kernel without the BSP. */
+#define configUSE_LOAD_TRACE                1
+
+#if configUSE_LOAD_TRACE > 0
+    #ifndef __ASSEMBLER__
+        void Load_IdleEnter( void );
+        void Load_IdleExit( void );
+    #endif
+    #define traceTASK_SWITCHED_IN()     if( pxCurrentTCB == xIdleTaskHandle ) { Load_IdleEnter(); }
+    #define traceTASK_SWITCHED_OUT()    if( pxCurrentTCB == xIdleTaskHandle ) { Load_IdleExit(); }
+#endif
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES               1
 #define configMAX_CO_ROUTINE_PRIORITIES     (2)
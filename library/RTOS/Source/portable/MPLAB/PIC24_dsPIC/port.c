@@ -332,3 +332,104 @@ const uint32_t ulCompareMatch = ( ( configCPU_CLOCK_HZ / portTIMER_PRESCALE ) /
 	/* Start the timer. */
 	T1CONbits.TON = 1;
 }
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+/* Timer 1 counts of one tick, and the number of ticks that fit the 16-bit
+period register (32 ticks at 1KHz). */
+#define portTIMER_COUNTS_PER_TICK	( ( uint16_t ) ( ( configCPU_CLOCK_HZ / portTIMER_PRESCALE ) / configTICK_RATE_HZ ) )
+#define portMAX_SUPPRESSED_TICKS	( ( TickType_t ) ( 0xffffUL / portTIMER_COUNTS_PER_TICK ) )
+
+/* Timer 1 counts lost while the timer is stopped to be corrected. */
+#ifndef portTICKLESS_STOP_COMPENSATION
+	#define portTICKLESS_STOP_COMPENSATION	4
+#endif
+
+/*
+ * The tick interrupt is suppressed by stretching the period of the timer 1
+ * up to the end of the expected idle time. The timer is not reset, so the
+ * tick boundaries are kept. The CPU enters the Idle mode (not the Sleep mode),
+ * so the peripheral clocks and the other timers keep running.
+ *
+ * The interrupts are masked at the kernel priority during the idle time. An
+ * enabled interrupt still wakes the CPU, the ones at the kernel priority are
+ * serviced after the tick count is corrected.
+ */
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+TickType_t xModifiableIdleTime, xCompleteTickPeriods;
+uint16_t usElapsed;
+
+	if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+	{
+		xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+	}
+
+	portDISABLE_INTERRUPTS();
+
+	/* A tick is pending, or a task was made ready while the scheduler was
+	suspended. */
+	if( ( IFS0bits.T1IF != 0 ) || ( eTaskConfirmSleepModeStatus() == eAbortSleep ) )
+	{
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	/* The application can shorten the idle time, less than two ticks keeps
+	the tick running. */
+	xModifiableIdleTime = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+	if( xModifiableIdleTime < 2 )
+	{
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	/* Stretch the period, the timer keeps counting from the last tick. */
+	PR1 = ( uint16_t ) ( portTIMER_COUNTS_PER_TICK * xModifiableIdleTime ) - 1;
+
+	/* The tick period ended just before the period was stretched. */
+	if( IFS0bits.T1IF != 0 )
+	{
+		PR1 = portTIMER_COUNTS_PER_TICK - 1;
+		portENABLE_INTERRUPTS();
+		return;
+	}
+
+	Idle();
+
+	T1CONbits.TON = 0;
+	if( IFS0bits.T1IF != 0 )
+	{
+		/* The stretched period completed. The pending interrupt counts the
+		last tick, the timer counts the next tick already. */
+		xCompleteTickPeriods = xModifiableIdleTime - 1;
+		TMR1 += portTICKLESS_STOP_COMPENSATION;
+	}
+	else
+	{
+		/* Woken by another interrupt. The timer holds the counts since the
+		last tick, the current tick is continued. */
+		usElapsed = TMR1 + portTICKLESS_STOP_COMPENSATION;
+		xCompleteTickPeriods = usElapsed / portTIMER_COUNTS_PER_TICK;
+		if( xCompleteTickPeriods >= xModifiableIdleTime )
+		{
+			xCompleteTickPeriods = xModifiableIdleTime - 1;
+			TMR1 = portTIMER_COUNTS_PER_TICK - 1;
+		}
+		else
+		{
+			TMR1 = usElapsed - ( xCompleteTickPeriods * portTIMER_COUNTS_PER_TICK );
+		}
+	}
+	PR1 = portTIMER_COUNTS_PER_TICK - 1;
+	T1CONbits.TON = 1;
+
+	vTaskStepTick( xCompleteTickPeriods );
+	configPOST_SLEEP_PROCESSING( xCompleteTickPeriods );
+
+	portENABLE_INTERRUPTS();
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
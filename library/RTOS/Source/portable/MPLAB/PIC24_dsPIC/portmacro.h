@@ -100,6 +100,12 @@ extern void vPortYield( void );
 
 #define portNOP()				asm volatile ( "NOP" )
 
+/* Tickless idle (see the port.c). */
+#if( configUSE_TICKLESS_IDLE == 1 )
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 #ifdef __cplusplus
 }
 #endif